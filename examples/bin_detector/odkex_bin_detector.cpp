@@ -265,7 +265,12 @@ public:
     void process(ProcessingContext& context, odk::IfHost *host) override
     {
         const auto channel_id = m_input_channel->getValue();
-        auto channel_iterator = context.m_channel_iterators[channel_id];
+        const auto found = context.m_channel_iterators.find(channel_id);
+        if (found == context.m_channel_iterators.end())
+        {
+            return;
+        }
+        auto channel_iterator = found->second;
 
         while (channel_iterator.valid())
         {
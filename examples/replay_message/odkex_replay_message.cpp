@@ -4,6 +4,7 @@
 #define  _SILENCE_ALL_CXX17_DEPRECATION_WARNINGS
 #endif
 
+#include "odkfw_background_source.h"
 #include "odkfw_properties.h"
 #include "odkfw_software_channel_plugin.h"
 #include "odkbase_message_return_value_holder.h"
@@ -15,7 +16,9 @@
 #include <codecvt>
 #include <filesystem>
 #include <fstream>
+#include <string>
 #include <string.h>
+#include <utility>
 
 // Manifest constains necessary metadata for oxygen plugins
 //   OxygenPlugin.name: unique plugin identifier; please use your (company) name to avoid name conflicts. This name is also used as a prefix in all custom config item keys.
@@ -66,6 +69,10 @@ std::map<std::string,
 
 static const double TIMEBASE_FREQUENCY = 1000000.0;
 
+// Number of messages read ahead per block, the file is replayed with constant memory
+static const std::size_t MESSAGES_PER_BLOCK = 256;
+static const std::size_t QUEUED_BLOCKS = 8;
+
 using namespace odk::framework;
 
 using FileType = EditableFilePathProperty::FileType;
@@ -77,18 +84,36 @@ namespace
         std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> wstring_converter;
         return wstring_converter.from_bytes(utf8s);
     }
+
+    struct Message
+    {
+        std::uint64_t m_tick;
+        std::vector<uint8_t> m_data;
+    };
+
+    // Messages read from the file by the producer thread, the message buffers are reused
+    struct MessageBlock
+    {
+        std::vector<Message> m_messages;
+        std::size_t m_count = 0;    // number of valid messages
+        std::size_t m_emitted = 0;  // number of messages already sent
+    };
 }
 
-class ReplayMessageChannel : public SoftwareChannelInstance
+class ReplayMessageChannel : public BackgroundSourceInstance<MessageBlock>
 {
 public:
 
     ReplayMessageChannel()
-        : m_input_file(new EditableFilePathProperty(FileType::INPUT_FILE, "", SELECT_INPUT_FILE, "", { "Supported Files (*.csv)" }))
+        : BackgroundSourceInstance<MessageBlock>(QUEUED_BLOCKS)
+        , m_input_file(new EditableFilePathProperty(FileType::INPUT_FILE, "", SELECT_INPUT_FILE, "", { "Supported Files (*.csv)" }))
         , m_channel_type(new SelectableProperty(odk::Property{ KEY_CHANNEL_TYPE, "ARINC_429", "DAQChannelType"} ))
         , m_neon_channel_type(new SelectableProperty(odk::Property{ KEY_CHANNEL_TYPE, "ARINC_429", "DAQChannelType" }))
+        , m_max_value_size(0)
         , m_file_duration(0)
-        , m_next_tick(std::numeric_limits<uint64_t>::max())
+        , m_loop_start(0)
+        , m_next_tick(0)
+        , m_loop_has_entries(false)
     {
         for (auto stype : SupportedTypes)
         {
@@ -96,6 +121,11 @@ public:
         }
     }
 
+    ~ReplayMessageChannel()
+    {
+        stopProducer();
+    }
+
     // Describe how the software channel should be shown in the "Add Channel" dialog
     static odk::RegisterSoftwareChannel getSoftwareChannelInfo()
     {
@@ -121,14 +151,10 @@ public:
     bool update() override
     {
         // channel is only valid if we can properly parse the specified csv file
+        // the file is only scanned for its duration here, the messages are read during processing
         // in production code the parsing should not be done on every config change, but only if the filename was updated
         CSVMessageReader csv;
-        const auto filename =
-            std::filesystem::path(toWString(m_input_file->getFilename()));
-        std::ifstream input_stream(filename.native());
-
-        m_next_tick = std::numeric_limits<uint64_t>::max();
-        m_values.clear();
+        std::ifstream input_stream(getInputPath().native());
 
         m_neon_channel_type->setValue(m_channel_type->getValue());
 
@@ -152,20 +178,27 @@ public:
         try
         {
             m_file_duration = 0;
-            if (input_stream && csv.parse(input_stream) && !csv.m_values.empty())
+            m_max_value_size = max_value_size;
+            CSVMessageReader::Entry entry;
+            std::size_t unsorted_entries = 0;
+            while (input_stream && csv.readEntry(input_stream, entry))
             {
-                for (auto& entry : csv.m_values)
+                uint64_t time = static_cast<uint64_t>(entry.m_time * TIMEBASE_FREQUENCY);
+                if (time + 1 < m_file_duration)
                 {
-                    uint64_t time = static_cast<uint64_t>(entry.m_time * TIMEBASE_FREQUENCY);
-                    m_file_duration = std::max(m_file_duration, time + 1);
-                    if (max_value_size && entry.m_message.size() > max_value_size)
-                    {
-                        entry.m_message.resize(max_value_size);
-                    }
-                    m_values[time] = entry.m_message;
+                    ++unsorted_entries;
                 }
+                m_file_duration = std::max(m_file_duration, time + 1);
             }
             is_valid &= m_file_duration > 0;
+
+            if (unsorted_entries > 0)
+            {
+                auto log_msg = getHost()->createValue<odk::IfStringValue>();
+                log_msg->set((std::to_string(unsorted_entries) + " messages in file '" + m_input_file->getFilename()
+                    + "' are out of order and will be skipped").c_str());
+                ODK_VERIFY(getHost()->messageAsync(odk::host_msg_async::LOG_MESSAGE, odk::LOGLEVEL_WARNING, log_msg.get()) == 0);
+            }
         }
         catch (...)
         {
@@ -219,55 +252,149 @@ public:
         return true;
     }
 
-    void prepareProcessing(odk::IfHost* host) override
+protected:
+    double getSourceFrequency() const override
     {
-        const auto ts = getMasterTimestamp(host);
-        const auto rate_factor = TIMEBASE_FREQUENCY / ts.m_frequency;
-        m_next_tick = static_cast<std::uint64_t>(ts.m_ticks* rate_factor);
+        return TIMEBASE_FREQUENCY;
     }
 
-    void process(ProcessingContext& context, odk::IfHost *host) override
+    // called before the producer thread is started: the file is looped, first_tick is located in the current loop
+    bool startProducing(std::uint64_t first_tick) override
     {
-        ODK_UNUSED(context);
-
         if (m_file_duration == 0)
         {
-            return;
+            return false;
         }
-        std::uint32_t channel_id = getRootChannel()->getLocalId();
-        auto ts = getMasterTimestamp(host);
-        const auto rate_factor = TIMEBASE_FREQUENCY / ts.m_frequency;
 
-        auto tick = m_next_tick;
-        std::uint64_t target_tick = static_cast<std::uint64_t>(ts.m_ticks * rate_factor);
-        while (tick < target_tick)
+        m_channel_id = getRootChannel()->getLocalId();
+        m_input_path = getInputPath();
+        m_input_stream = std::ifstream(m_input_path.native());
+        m_csv = CSVMessageReader();
+        m_loop_duration = m_file_duration;
+        m_loop_max_value_size = m_max_value_size;
+        m_loop_start = first_tick / m_loop_duration * m_loop_duration;
+        m_next_tick = first_tick;
+        m_loop_last_tick = m_loop_start;
+        m_loop_has_entries = false;
+        m_has_pending = false;
+        return true;
+    }
+
+    // called on the producer thread, blocks until process() has emitted enough data
+    // messages have to be sorted by time, messages before the previous one are skipped (reported in update())
+    // of several messages with the same timestamp only the last one is replayed
+    bool produceBlock(MessageBlock& block) override
+    {
+        block.m_count = 0;
+        block.m_emitted = 0;
+        while (block.m_count < MESSAGES_PER_BLOCK)
         {
-            const auto rel_base = tick / m_file_duration;
-            const auto rel_tick = tick % m_file_duration;
-            const auto value_it = rel_tick == 0 ? m_values.begin() : m_values.upper_bound(rel_tick - 1);
+            if (!m_csv.readEntry(m_input_stream, m_entry))
+            {
+                if (!m_loop_has_entries)
+                {
+                    // the file has been changed and does not contain messages anymore
+                    if (m_has_pending)
+                    {
+                        addPending(block);
+                    }
+                    return block.m_count > 0;
+                }
+                // restart at the beginning of the file
+                m_loop_start += m_loop_duration;
+                m_loop_last_tick = m_loop_start;
+                m_input_stream = std::ifstream(m_input_path.native());
+                m_csv = CSVMessageReader();
+                m_loop_has_entries = false;
+                continue;
+            }
 
-            if (value_it == m_values.end())
+            m_loop_has_entries = true;
+            const auto tick = m_loop_start + static_cast<std::uint64_t>(m_entry.m_time * TIMEBASE_FREQUENCY);
+            if (tick < m_loop_last_tick)
             {
-                tick = std::min(target_tick, (rel_base + 1) * m_file_duration);
+                // out of order
+                continue;
             }
-            else
+            m_loop_last_tick = tick;
+            if (tick < m_next_tick)
             {
-                tick = rel_base * m_file_duration + value_it->first;
-                addSample(host, channel_id, tick, value_it->second.data(), value_it->second.size());
-                ++tick;
+                continue;
             }
+
+            // a message is only added to the block when the next one has a later timestamp
+            if (m_has_pending && m_pending.m_tick != tick)
+            {
+                addPending(block);
+            }
+            m_pending.m_tick = tick;
+            auto size = m_entry.m_message.size();
+            if (m_loop_max_value_size && size > m_loop_max_value_size)
+            {
+                size = m_loop_max_value_size;
+            }
+            m_pending.m_data.assign(m_entry.m_message.begin(), m_entry.m_message.begin() + size);
+            m_has_pending = true;
         }
-        m_next_tick = tick;
+        return true;
+    }
+
+    void stopProducing() override
+    {
+        m_input_stream.close();
+    }
+
+    bool emitBlock(MessageBlock& block, std::uint64_t target_tick, odk::IfHost* host) override
+    {
+        for (; block.m_emitted < block.m_count; ++block.m_emitted)
+        {
+            const auto& message = block.m_messages[block.m_emitted];
+            if (message.m_tick >= target_tick)
+            {
+                return false;
+            }
+            addSample(host, m_channel_id, message.m_tick, message.m_data.data(), message.m_data.size());
+        }
+        return true;
     }
 
 private:
+    std::filesystem::path getInputPath() const
+    {
+        return std::filesystem::path(toWString(m_input_file->getFilename()));
+    }
+
+    void addPending(MessageBlock& block)
+    {
+        if (block.m_messages.size() == block.m_count)
+        {
+            block.m_messages.emplace_back();
+        }
+        // swap to keep the message buffers
+        std::swap(block.m_messages[block.m_count++], m_pending);
+        m_has_pending = false;
+    }
+
     std::shared_ptr<EditableFilePathProperty> m_input_file;
     std::shared_ptr<SelectableProperty> m_channel_type;
     std::shared_ptr<SelectableProperty> m_neon_channel_type;
-    std::map<uint64_t, std::vector<uint8_t>> m_values;
+    std::size_t m_max_value_size;
     uint64_t m_file_duration;
 
-    std::uint64_t m_next_tick; // timestamp of the next sample that will be generated in doProcess()
+    // state of the producer thread, only accessed by the main thread while it is stopped
+    std::uint32_t m_channel_id = 0;
+    std::filesystem::path m_input_path;
+    std::ifstream m_input_stream;
+    CSVMessageReader m_csv;
+    CSVMessageReader::Entry m_entry;
+    std::uint64_t m_loop_duration = 0;
+    std::size_t m_loop_max_value_size = 0;
+    std::uint64_t m_loop_start;     // timestamp of the start of the current file loop
+    std::uint64_t m_next_tick;      // timestamp of the first message that is replayed
+    std::uint64_t m_loop_last_tick = 0; // latest timestamp read in the current file loop
+    bool m_loop_has_entries;
+    Message m_pending;              // last message read, replaced by following messages with the same timestamp
+    bool m_has_pending = false;
 };
 
 class ReplayMessagePlugin : public SoftwareChannelPlugin<ReplayMessageChannel>
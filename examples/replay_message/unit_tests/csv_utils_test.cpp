@@ -2,6 +2,7 @@
 
 #include "sdk_csv_utils.h"
 
+#include <sstream>
 #include <tuple>
 #include <boost/test/unit_test.hpp>
 
@@ -29,4 +30,55 @@ BOOST_AUTO_TEST_CASE(AsciiHexToBitsTest)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(CSVNumberReaderReadRowTest)
+{
+	std::istringstream input("time,value\n\n1.0,2.5\n2.0,\n3.0;4.5\nfoo,bar\n5.0,6.0\n");
+	CSVNumberReader csv;
+	std::vector<double> values;
+
+	BOOST_REQUIRE(csv.readRow(input, values));
+	BOOST_CHECK_EQUAL(csv.m_headers.size(), 2);
+	BOOST_CHECK_EQUAL(values.size(), 2);
+	BOOST_CHECK_EQUAL(values[1], 2.5);
+
+	BOOST_REQUIRE(csv.readRow(input, values));
+	BOOST_CHECK_EQUAL(values.size(), 2);
+	BOOST_CHECK(values[1] != values[1]);
+
+	BOOST_REQUIRE(csv.readRow(input, values));
+	BOOST_CHECK_EQUAL(values[1], 4.5);
+
+	// a second header line is invalid, reading stops there
+	BOOST_CHECK(!csv.readRow(input, values));
+	BOOST_CHECK(csv.m_failed);
+	BOOST_CHECK(!csv.readRow(input, values));
+	BOOST_CHECK_EQUAL(csv.m_row_count, 3);
+
+	std::istringstream parse_input("time,value\n1.0,2.5\n2.0,3.5");
+	BOOST_CHECK(csv.parse(parse_input));
+	BOOST_CHECK_EQUAL(csv.m_values.size(), 2);
+	BOOST_CHECK_EQUAL(csv.m_values[1][1], 3.5);
+}
+
+BOOST_AUTO_TEST_CASE(CSVMessageReaderReadEntryTest)
+{
+	std::istringstream input("time,message\n0.5,0102\n\n1.5;0304 05\n");
+	CSVMessageReader csv;
+	CSVMessageReader::Entry entry;
+
+	BOOST_REQUIRE(csv.readEntry(input, entry));
+	BOOST_CHECK_EQUAL(csv.m_headers.size(), 2);
+	BOOST_CHECK_EQUAL(entry.m_time, 0.5);
+	std::vector<uint8_t> expected = {1, 2};
+	BOOST_CHECK_EQUAL_COLLECTIONS(entry.m_message.begin(), entry.m_message.end(), expected.begin(), expected.end());
+
+	BOOST_REQUIRE(csv.readEntry(input, entry));
+	BOOST_CHECK_EQUAL(entry.m_time, 1.5);
+	expected = {3, 4, 5};
+	BOOST_CHECK_EQUAL_COLLECTIONS(entry.m_message.begin(), entry.m_message.end(), expected.begin(), expected.end());
+
+	BOOST_CHECK(!csv.readEntry(input, entry));
+	BOOST_CHECK_EQUAL(csv.m_line_count, 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 #endif
 
 #include "odkapi_config_item_keys.h"
+#include "odkfw_background_source.h"
 #include "odkfw_custom_request_handler.h"
 #include "odkfw_properties.h"
 #include "odkfw_software_channel_plugin.h"
@@ -14,6 +15,8 @@
 #include "qml.rcc.h"
 #include "sdk_csv_utils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <codecvt>
 #include <filesystem>
 #include <fstream>
@@ -56,6 +59,12 @@ R"XML(<?xml version="1.0"?>
 // Custom key (prefixed by plugin name) to store path to the input file
 static const char* KEY_INPUT_FILE = "ODK_REPLAY_SYNC_SCALAR/InputFile";
 
+// Blocks read ahead of the acquisition, the file is replayed with constant memory
+// Each block covers a fixed time span, so high sample rates get larger blocks
+static const double BLOCK_DURATION = 0.05;
+static const std::size_t MIN_SAMPLES_PER_BLOCK = 256;
+static const std::size_t QUEUED_BLOCKS = 8;
+
 using namespace odk::framework;
 
 namespace
@@ -65,16 +74,31 @@ namespace
         std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> wstring_converter;
         return wstring_converter.from_bytes(utf8s);
     }
+
+    // Samples read from the file by the producer thread
+    struct SampleBlock
+    {
+        std::uint64_t m_tick = 0;       // timestamp of the first sample
+        std::size_t m_emitted = 0;      // number of samples already sent
+        std::vector<double> m_values;
+    };
 }
 
-class ReplayChannel : public SoftwareChannelInstance
+class ReplayChannel : public BackgroundSourceInstance<SampleBlock>
 {
 public:
 
     ReplayChannel()
-        : m_input_file(new EditableStringProperty(""))
-        , m_next_tick(std::numeric_limits<uint64_t>::max())
+        : BackgroundSourceInstance<SampleBlock>(QUEUED_BLOCKS)
+        , m_input_file(new EditableStringProperty(""))
+        , m_row_count(0)
+        , m_next_tick(0)
+    {
+    }
+
+    ~ReplayChannel()
     {
+        stopProducer();
     }
 
     // Describe how the software channel should be shown in the "Add Channel" dialog
@@ -120,38 +144,32 @@ public:
     bool update() override
     {
         // channel is only valid if we can properly parse the specified csv file
+        // the file is only scanned for the range here, the samples are read during processing
         // in production code the parsing should not be done on every config change, but only if the filename was updated
         CSVNumberReader csv;
-        const auto filename =
-            std::filesystem::path(toWString(m_input_file->getValue()));
-        std::ifstream input_stream(filename.native());
+        std::ifstream input_stream(getInputPath().native());
 
-        m_next_tick = std::numeric_limits<uint64_t>::max();
-        m_values.clear();
+        m_row_count = 0;
 
         double range_min = std::numeric_limits<double>::max();
         double range_max = std::numeric_limits<double>::lowest();
 
-        if (input_stream && csv.parse(input_stream) && !csv.m_values.empty())
+        std::vector<double> row_values;
+        const size_t column_index = 0;
+        while (input_stream && csv.readRow(input_stream, row_values))
         {
-            m_values.reserve(csv.m_values.size());
-            size_t column_index = 0;
-            for (const auto& row_values : csv.m_values)
+            if (row_values.size() > column_index)
             {
-                if (row_values.size() > column_index)
-                {
-                    range_min = std::min(range_min, row_values[column_index]);
-                    range_max = std::max(range_max, row_values[column_index]);
-                    m_values.push_back(row_values[column_index]);
-                }
-                else
-                {
-                    m_values.push_back(std::numeric_limits<double>::quiet_NaN());
-                }
+                range_min = std::min(range_min, row_values[column_index]);
+                range_max = std::max(range_max, row_values[column_index]);
             }
         }
+        if (!csv.m_failed)
+        {
+            m_row_count = csv.m_row_count;
+        }
 
-        bool is_valid = range_min <= range_max;
+        bool is_valid = m_row_count > 0 && range_min <= range_max;
 
         getRootChannel()->setRange({range_min, range_max, "", ""});
         getRootChannel()->setValid(is_valid);
@@ -191,39 +209,103 @@ public:
         return true;
     }
 
-    void prepareProcessing(odk::IfHost* host) override
+protected:
+    double getSourceFrequency() const override
+    {
+        return m_sample_rate->getValue().m_val;
+    }
+
+    // called before the producer thread is started: open the file and skip to the sample of first_tick
+    bool startProducing(std::uint64_t first_tick) override
     {
-        const auto ts = getMasterTimestamp(host);
-        const auto rate_factor = m_sample_rate->getValue().m_val / ts.m_frequency;
-        m_next_tick = static_cast<std::uint64_t>(ts.m_ticks* rate_factor);
+        if (m_row_count == 0)
+        {
+            return false;
+        }
+
+        m_channel_id = getRootChannel()->getLocalId();
+        m_input_path = getInputPath();
+        m_input_stream = std::ifstream(m_input_path.native());
+        m_csv = CSVNumberReader();
+        m_next_tick = first_tick;
+        m_samples_per_block = std::max(MIN_SAMPLES_PER_BLOCK,
+            static_cast<std::size_t>(std::ceil(getSourceFrequency() * BLOCK_DURATION)));
+
+        // the file is looped, sample i is replayed at every tick t with t % row_count == i
+        for (auto skip = first_tick % m_row_count; skip > 0; --skip)
+        {
+            if (!m_csv.readRow(m_input_stream, m_row_values))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
-    void process(ProcessingContext& context, odk::IfHost *host) override
+    // called on the producer thread, blocks until process() has emitted enough data
+    bool produceBlock(SampleBlock& block) override
     {
-        ODK_UNUSED(context);
+        block.m_tick = m_next_tick;
+        block.m_emitted = 0;
+        block.m_values.clear();
+        block.m_values.reserve(m_samples_per_block);
+        while (block.m_values.size() < m_samples_per_block)
+        {
+            if (!m_csv.readRow(m_input_stream, m_row_values))
+            {
+                if (m_csv.m_row_count == 0)
+                {
+                    // the file has been changed and does not contain data anymore
+                    return false;
+                }
+                // restart at the beginning of the file
+                m_input_stream = std::ifstream(m_input_path.native());
+                m_csv = CSVNumberReader();
+                continue;
+            }
+            block.m_values.push_back(m_row_values.empty() ? std::numeric_limits<double>::quiet_NaN() : m_row_values.front());
+        }
+        m_next_tick += block.m_values.size();
+        return true;
+    }
 
-        std::uint32_t channel_id = getRootChannel()->getLocalId();
-        auto ts = getMasterTimestamp(host);
+    void stopProducing() override
+    {
+        m_input_stream.close();
+    }
 
-        auto tick = m_next_tick;
-        const auto rate_factor = m_sample_rate->getValue().m_val / ts.m_frequency;
-        std::uint64_t target_tick = static_cast<std::uint64_t>(ts.m_ticks * rate_factor);
-        while (tick < target_tick)
+    bool emitBlock(SampleBlock& block, std::uint64_t target_tick, odk::IfHost* host) override
+    {
+        const auto tick = block.m_tick + block.m_emitted;
+        if (tick >= target_tick)
         {
-            auto idx = tick % m_values.size();
-            auto sz = std::min(m_values.size() - idx, target_tick - tick);
-            addSamples(host, channel_id, tick, &m_values[idx], sizeof(double) * sz);
-            tick += sz;
+            return false;
         }
-        m_next_tick = tick;
+
+        const auto count = std::min<std::uint64_t>(block.m_values.size() - block.m_emitted, target_tick - tick);
+        addSamples(host, m_channel_id, tick, &block.m_values[block.m_emitted], sizeof(double) * count);
+        block.m_emitted += count;
+        return block.m_emitted == block.m_values.size();
     }
 
 private:
+    std::filesystem::path getInputPath() const
+    {
+        return std::filesystem::path(toWString(m_input_file->getValue()));
+    }
+
     std::shared_ptr<EditableStringProperty> m_input_file;
     std::shared_ptr<EditableScalarProperty> m_sample_rate;
-    std::vector<double> m_values;
-
-    std::uint64_t m_next_tick; // timestamp of the next sample that will be generated in doProcess()
+    std::size_t m_row_count;   // number of samples in the file, checked in update()
+
+    // state of the producer thread, only accessed by the main thread while it is stopped
+    std::uint32_t m_channel_id = 0;
+    std::filesystem::path m_input_path;
+    std::ifstream m_input_stream;
+    CSVNumberReader m_csv;
+    std::vector<double> m_row_values;
+    std::size_t m_samples_per_block = MIN_SAMPLES_PER_BLOCK;
+    std::uint64_t m_next_tick; // timestamp of the next sample that will be read by the producer
 };
 
 class ReplaySyncScalarPlugin : public SoftwareChannelPlugin<ReplayChannel>
@@ -191,6 +191,9 @@ public:
         m_last_timestamp = 0;
         m_last_sample = 0;
         m_has_last = false;
+
+        // the slot of the input channel stays the same until processing is stopped
+        m_input_slot = getChannelSlot(m_input_channel->getValue());
     }
 
     /**
@@ -215,8 +218,7 @@ public:
         const std::uint64_t start_sample = odk::convertTimeToTickAtOrAfter(context.m_window.first, m_timebase_frequency);
         const std::uint64_t end_sample =   odk::convertTimeToTickAtOrAfter(context.m_window.second, m_timebase_frequency);
 
-        const std::uint64_t channel_id = m_input_channel->getValue();
-        odk::framework::StreamIterator& iterator = context.m_channel_iterators[channel_id];
+        odk::framework::StreamIterator& iterator = context.m_channel_iterators.getIterator(m_input_slot);
         iterator.setSkipGaps(false);
 
         const auto upsample_factor = m_upsample_factor->getValue();
@@ -224,8 +226,9 @@ public:
         if (m_is_sync)
         {
             // Process a sync channel: Store the samples in a buffer and output them in one batch
+            // (the scratch buffer is released by the framework after process() and reused in the next call)
             const std::size_t num_output_samples = end_sample - start_sample;
-            std::vector<double> samples(num_output_samples * upsample_factor);
+            auto samples = context.m_scratch->allocate<double>(num_output_samples * upsample_factor);
             std::size_t output_sample_index = 0;
             uint64_t output_start_sample = start_sample * upsample_factor;
 
@@ -312,6 +315,7 @@ private:
     uint64_t m_last_timestamp = 0;
     double m_last_sample = 0;
     bool m_has_last = false;
+    std::size_t m_input_slot = odk::framework::ChannelIteratorTable::NO_SLOT;
 };
 
 class SampleInterpolatorPlugin : public odk::framework::SoftwareChannelPlugin<SampleInterpolatorChannelInstance>
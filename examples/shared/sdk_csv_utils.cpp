@@ -85,11 +85,22 @@ std::vector<std::string> CSVNumberReader::parseLine(std::istream& input)
 bool CSVNumberReader::parse(std::istream& input)
 {
     m_columns = 0;
+    m_row_count = 0;
+    m_failed = false;
     m_headers.clear();
     m_values.clear();
 
-    bool success = true;
-    while (input)
+    std::vector<double> values;
+    while (readRow(input, values))
+    {
+        m_values.push_back(values);
+    }
+    return !m_failed;
+}
+
+bool CSVNumberReader::readRow(std::istream& input, std::vector<double>& values)
+{
+    while (input && !m_failed)
     {
         const auto& fields = parseLine(input);
 
@@ -101,7 +112,7 @@ bool CSVNumberReader::parse(std::istream& input)
 
         m_columns = std::max(m_columns, fields.size());
 
-        std::vector<double> values;
+        values.clear();
         bool all_valid = true;
         values.reserve(fields.size());
         for (const auto& field : fields)
@@ -123,28 +134,26 @@ bool CSVNumberReader::parse(std::istream& input)
         }
         if (all_valid)
         {
-            m_values.push_back(std::move(values));
+            ++m_row_count;
+            return true;
         }
-        else
+
+        // we have no valid data => this is a header line
+        if (m_row_count == 0 && m_headers.empty())
         {
-            // we have no valid data => this is a header line
-            if (m_values.empty() && m_headers.empty())
-            {
-                for (const auto& field : fields)
-                {
-                    std::string f = field;
-                    trim(f);
-                    m_headers.push_back(f);
-                }
-            }
-            else
+            for (const auto& field : fields)
             {
-                success = false;
-                break;
+                std::string f = field;
+                trim(f);
+                m_headers.push_back(f);
             }
         }
+        else
+        {
+            m_failed = true;
+        }
     }
-    return success;
+    return false;
 }
 
 
@@ -219,14 +228,25 @@ std::vector<uint8_t> AsciiHexToBits(const std::string& input)
 
 bool CSVMessageReader::parse(std::istream& input)
 {
+    m_line_count = 0;
     m_headers.clear();
     m_values.clear();
 
+    Entry entry;
+    while (readEntry(input, entry))
+    {
+        m_values.push_back(entry);
+    }
+
+    return (m_values.size() + 1 <= m_line_count);
+}
+
+bool CSVMessageReader::readEntry(std::istream& input, Entry& entry)
+{
     std::string line;
-    auto line_count = 0u;
     while (input && std::getline(input, line))
     {
-        ++line_count;
+        ++m_line_count;
         const auto& fields = tokenize(line, ",; \t\r");
 
         // skip empty lines
@@ -235,7 +255,6 @@ bool CSVMessageReader::parse(std::istream& input)
             continue;
         }
 
-        Entry entry;
         if (fields.size() >= 2)
         {
             char* endptr;
@@ -244,6 +263,7 @@ bool CSVMessageReader::parse(std::istream& input)
 
             if (is_valid)
             {
+                entry.m_message.clear();
                 std::for_each(fields.begin() + 1, fields.end(),
                     [&entry]
                     (const std::string& val)
@@ -251,15 +271,14 @@ bool CSVMessageReader::parse(std::istream& input)
                         auto v = AsciiHexToBits(val);
                         std::copy(v.begin(), v.end(), std::back_inserter(entry.m_message));
                     });
-                m_values.emplace_back(entry);
+                return true;
             }
-            else if (line_count == 1)
+            else if (m_line_count == 1)
             {
                 std::copy(fields.begin(), fields.end(), std::back_inserter(m_headers));
             }
         }
     }
-
-    return (m_values.size() + 1 <= line_count);
+    return false;
 }
 
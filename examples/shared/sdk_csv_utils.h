@@ -22,7 +22,13 @@ public:
     std::vector<std::string> parseLine(std::istream& input);
     bool parse(std::istream& input);
 
+    // Reads the next data row without storing it, a header line before the first row is stored in m_headers.
+    // Returns false at the end of the input or if an invalid line has been read (m_failed is set then).
+    bool readRow(std::istream& input, std::vector<double>& values);
+
     size_t m_columns = 0;
+    size_t m_row_count = 0;
+    bool m_failed = false;
 
     std::vector<std::string> m_headers;
     std::vector<std::vector<double>> m_values;
@@ -41,6 +47,12 @@ public:
         std::vector<uint8_t> m_message;
     };
 
+    // Reads the next entry without storing it, reuses the message buffer of entry.
+    // A header in the first line is stored in m_headers. Returns false at the end of the input.
+    bool readEntry(std::istream& input, Entry& entry);
+
+    size_t m_line_count = 0;
+
     std::vector<std::string> m_headers;
     std::vector<Entry> m_values;
 };
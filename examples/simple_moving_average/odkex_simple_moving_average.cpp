@@ -1,11 +1,11 @@
 // Copyright DEWETRON GmbH 2022
 
+#include "odkfw_contiguous_sample_buffer.h"
+#include "odkfw_moving_window.h"
 #include "odkfw_properties.h"
 #include "odkfw_software_channel_plugin.h"
 #include "odkapi_utils.h"
 
-#include <numeric>
-
 static const char* PLUGIN_MANIFEST =
 R"XML(<?xml version="1.0"?>
 <OxygenPlugin name="ODK_SIMPLE_MOVING_AVERAGE" version="1.0" uuid="E9698711-6DC4-4391-8DD0-F3455D64AA98">
@@ -49,7 +49,7 @@ public:
 
     SmaExampleSoftwareChannelInstance()
         : m_input_channel(std::make_shared<EditableChannelIDProperty>())
-        , m_window_size(std::make_shared<EditableUnsignedProperty>(3, 1, 99))
+        , m_window_size(std::make_shared<EditableUnsignedProperty>(3, 1, 1000000))
     {
         // make properties visible in the GUI
         m_input_channel->setVisiblity("PUBLIC");
@@ -181,8 +181,7 @@ public:
     {
         ODK_UNUSED(host);
 
-        m_input_buffer.clear();
-        m_input_buffer.reserve(m_window_size->getValue());
+        m_window.setWindowSize(m_window_size->getValue());
         m_next_output_tick = 0; // set to uninitialized state
     }
 
@@ -198,8 +197,8 @@ public:
             return;
         }
 
-        // read calculation settings
-        const unsigned int window_size = m_window_size->getValue();
+        // the window size is applied in prepareProcessing()
+        const std::size_t window_size = m_window.getWindowSize();
 
         ODK_ASSERT_EQUAL(context.m_channel_iterators.size(), 1);
         auto& iterator = context.m_channel_iterators.begin()->second;
@@ -211,29 +210,40 @@ public:
         const std::uint64_t start_sample = odk::convertTimeToTickAtOrAfter(context.m_window.first, m_timebase_frequency);
         const std::uint64_t end_sample = odk::convertTimeToTickAtOrAfter(context.m_window.second, m_timebase_frequency);
 
-        // Prepare output buffer (it can be a local variable since we emit all values to the output channel within one process() call)
-        std::vector<double> output_buffer;
+        // Prepare output buffer (all values are emitted within one process() call, the member only keeps the memory for the next call)
+        auto& output_buffer = m_output_buffer;
+        output_buffer.clear();
         output_buffer.reserve(end_sample - start_sample);
 
-        // Read all samples from the channel iterator
-        for (auto sample_index = start_sample; sample_index < end_sample; ++sample_index)
+        // Read all samples from the channel iterator, one block (chunk) at a time
+        std::uint64_t remaining_samples = end_sample - start_sample;
+        while (remaining_samples > 0)
         {
-            const double sample_value = iterator.value<double>();
-            ++iterator;
-
-            // add sample to input buffer (note that when reading across a gap, invalid (NaN) values are added and the output value will automatically be NaN when invalid values are present)
-            m_input_buffer.push_back(sample_value);
-            
-            // check if we can compute an output
-            if (m_input_buffer.size() == window_size)
+            const auto chunk = iterator.nextChunk<double>(remaining_samples);
+            if (chunk.empty())
             {
-                // compute average over all samples in the window
-                const double average = std::accumulate(m_input_buffer.begin(), m_input_buffer.end(), 0.0) / window_size;
-                output_buffer.push_back(average);
+                break;
+            }
+            remaining_samples -= chunk.m_count;
 
-                // erase first sample in input buffer
-                m_input_buffer.erase(m_input_buffer.begin());
+            // samples of a block are usually stored as a plain array, otherwise (and for gaps) they are copied first
+            // note that when reading across a gap, invalid (NaN) values are added and the output value is NaN while they are in the window
+            const double* input = chunk.m_data;
+            if (chunk.isGap() || !chunk.isContiguous())
+            {
+                m_chunk_buffer.resize(chunk.m_count);
+                for (std::size_t i = 0; i < chunk.m_count; ++i)
+                {
+                    m_chunk_buffer[i] = chunk.value(i);
+                }
+                input = m_chunk_buffer.data();
             }
+
+            // the window keeps a running sum, every sample that completes a full window adds one output value
+            const auto offset = output_buffer.size();
+            output_buffer.resize(offset + chunk.m_count);
+            const auto written = m_window.addSamples(input, chunk.m_count, output_buffer.data() + offset);
+            output_buffer.resize(offset + written);
         }
 
         // check if output_tick is uninitialized and compute the initial value
@@ -247,7 +257,8 @@ public:
         // Write several consecutive output samples to the output channel
         if (!output_buffer.empty())
         {
-            addSamples(host, sync_out_channel->getLocalId(), m_next_output_tick, output_buffer.data(), sizeof(double) * output_buffer.size());
+            // the buffer already holds the complete ADD_CONTIGUOUS_SAMPLES payload, it is sent without copying the samples
+            output_buffer.send(host, sync_out_channel->getLocalId(), m_next_output_tick);
             // advance the output tick for the next call of process()
             m_next_output_tick += output_buffer.size();
         }
@@ -256,7 +267,9 @@ public:
 private:
     std::shared_ptr<EditableChannelIDProperty> m_input_channel;
     std::shared_ptr<EditableUnsignedProperty> m_window_size;
-    std::vector<double> m_input_buffer;
+    MovingWindow<double> m_window;
+    std::vector<double> m_chunk_buffer;
+    ContiguousSampleBuffer<double> m_output_buffer;
     std::uint64_t m_next_output_tick = 0;
     double m_timebase_frequency = 0.0;
 };
@@ -1,5 +1,6 @@
 // Copyright DEWETRON GmbH 2019-2021
 
+#include "odkfw_contiguous_sample_buffer.h"
 #include "odkfw_properties.h"
 #include "odkfw_software_channel_plugin.h"
 #include "odkapi_utils.h"
@@ -54,6 +55,7 @@ public:
         : m_input_channels(std::make_shared<EditableChannelIDListProperty>())
         , m_calculation_mode(std::make_shared<SelectableProperty>(odk::Property(KEY_CALC_MODE, "Sum", "")))
         , m_current_values({ std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN() })
+        , m_input_slots({ ChannelIteratorTable::NO_SLOT, ChannelIteratorTable::NO_SLOT })
     {
         // make property m_input_channels visible in the GUI
         m_input_channels->setVisiblity("PUBLIC");
@@ -232,6 +234,13 @@ public:
         ODK_UNUSED(host);
 
         m_current_values.fill(std::numeric_limits<double>::quiet_NaN());
+
+        // resolve the iterator slots once, process() accesses the iterators by index
+        const auto channel_ids = m_input_channels->getValue().m_values;
+        for (std::size_t index = 0; index < m_input_slots.size(); ++index)
+        {
+            m_input_slots[index] = getChannelSlot(channel_ids.at(index));
+        }
     }
 
     void process(ProcessingContext& context, odk::IfHost *host) override
@@ -244,9 +253,10 @@ public:
 
         auto prepare_iterator = [this, &context](std::size_t index) -> std::pair<odk::framework::StreamIterator, double>
         {
-            const std::uint64_t channel_id = m_input_channels->getValue().m_values.at(index);
-            context.m_channel_iterators[channel_id].setSkipGaps(false);
-            return std::make_pair(context.m_channel_iterators[channel_id], getInputChannelProxy(channel_id)->getTimeBase().m_frequency);
+            auto& iterator = context.m_channel_iterators.getIterator(m_input_slots[index]);
+            iterator.setSkipGaps(false);
+            const std::uint64_t channel_id = context.m_channel_iterators.getChannelId(m_input_slots[index]);
+            return std::make_pair(iterator, getInputChannelProxy(channel_id)->getTimeBase().m_frequency);
         };
 
         std::array<std::pair<odk::framework::StreamIterator, double>, 2> iterators = {
@@ -257,7 +267,9 @@ public:
         std::uint64_t start_sample = odk::convertTimeToTickAtOrAfter(context.m_window.first,  m_timebase_frequency);
         std::uint64_t end_sample =   odk::convertTimeToTickAtOrAfter(context.m_window.second, m_timebase_frequency);
 
-        std::vector<double> samples(end_sample - start_sample);
+        // samples are computed directly into the message payload, the buffer is kept for the next call
+        auto& samples = m_output_buffer;
+        samples.resize(end_sample - start_sample);
         std::size_t output_sample_index = 0;
 
         auto calculation_mode = m_calculation_mode->getValue().getEnumValue();
@@ -271,6 +283,8 @@ public:
                 const double output_time = odk::convertTickToTime(sample_index, m_timebase_frequency);
 
                 // Read all input channels up until output_time (channels with slower sample rate might reuse the old value when no newer sample is available)
+                // This merges monotonic streams and visits every input sample once. Each output needs the last sample at or before
+                // output_time, which seek() (first sample at or after a tick) would step over, so the walk is kept.
                 for (std::size_t channel_index = 0; channel_index < 2; ++channel_index)
                 {
                     auto& iterator = iterators[channel_index].first;
@@ -299,27 +313,40 @@ public:
         }
         else
         {
-            // no resampling required, read every sample from both input channels and compute an output sample
-            for (auto sample_index = start_sample; sample_index < end_sample; ++sample_index)
+            // no resampling required, read both input channels block by block and combine them into the output samples
+            const std::size_t sample_count = samples.size();
+            for (std::size_t channel_index = 0; channel_index < 2; ++channel_index)
             {
-                for (std::size_t channel_index = 0; channel_index < 2; ++channel_index)
+                auto& iterator = iterators[channel_index].first;
+                std::size_t index = 0;
+                while (index < sample_count)
                 {
-                    auto& iterator = iterators[channel_index].first;
-                    if (iterator.valid())
+                    const auto chunk = iterator.nextChunk<double>(sample_count - index);
+                    if (chunk.empty())
                     {
-                        m_current_values[channel_index] = iterator.value<double>();
-                        ++iterator;
+                        break;
                     }
+                    for (std::size_t i = 0; i < chunk.m_count; ++i)
+                    {
+                        combineValue(samples[index + i], chunk.value(i), channel_index, compute_sum);
+                    }
+                    m_current_values[channel_index] = chunk.value(chunk.m_count - 1);
+                    index += chunk.m_count;
                 }
 
-                samples[output_sample_index++] = compute_sum ? computeSum() : computeDifference();
+                // channel has no more samples in this window: keep using the last value
+                for (; index < sample_count; ++index)
+                {
+                    combineValue(samples[index], m_current_values[channel_index], channel_index, compute_sum);
+                }
             }
+            output_sample_index = sample_count;
         }
 
         if (output_sample_index > 0)
         {
             // write "output_sample_index" samples to the output channel
-            addSamples(host, sync_out_channel->getLocalId(), start_sample, samples.data(), sizeof(double) * output_sample_index);
+            samples.send(host, sync_out_channel->getLocalId(), start_sample, output_sample_index);
         }
     }
 
@@ -343,6 +370,21 @@ private:
         return m_current_values[0] - m_current_values[1];
     }
 
+    /**
+     * Combine the value of one input channel into an output sample (the first channel initializes the output sample)
+     */
+    static inline void combineValue(double& output, double value, std::size_t channel_index, bool compute_sum)
+    {
+        if (channel_index == 0)
+        {
+            output = value;
+        }
+        else
+        {
+            output = compute_sum ? output + value : output - value;
+        }
+    }
+
     /**
      * If all channels are synchronous and have the same sample rate, we can directly sum the input values. Otherwise, we need to resample. 
      */
@@ -368,6 +410,8 @@ private:
     std::shared_ptr<EditableChannelIDListProperty> m_input_channels;
     std::shared_ptr<SelectableProperty> m_calculation_mode;
     std::array<double, 2> m_current_values;
+    std::array<std::size_t, 2> m_input_slots;
+    ContiguousSampleBuffer<double> m_output_buffer;
     bool m_resampling_enabled = false;
     double m_timebase_frequency = 0.0;
 };
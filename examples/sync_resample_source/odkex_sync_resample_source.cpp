@@ -120,9 +120,9 @@ public:
         m_t_prev = 0;
     }
 
-    std::vector<double> generateSignalRamp(std::size_t num_samples)
+    odk::framework::ScratchBuffer<double> generateSignalRamp(odk::framework::ScratchArena& scratch, std::size_t num_samples)
     {
-        std::vector<double> samples(num_samples);
+        auto samples = scratch.allocate<double>(num_samples);
         for (std::size_t n = 0; n < num_samples; ++n)
         {
             if (n < num_samples / 4)
@@ -158,7 +158,7 @@ public:
         // only generate samples up until the master timestamp (not into the future)
         if (master_timestamp.m_ticks > (m_resampler.getSampleCount() + block_size) / m_timebase_frequency * master_timestamp.m_frequency)
         {
-            auto samples = generateSignalRamp(block_size);
+            auto samples = generateSignalRamp(*context.m_scratch, block_size);
             double t = m_t_prev + samples.size() / m_true_sample_rate->getValue().m_val;
             m_resampler.addSamples(host, out_channel->getLocalId(), t, samples.data(), samples.size());
             m_t_prev = t;
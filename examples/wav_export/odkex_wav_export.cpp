@@ -32,7 +32,11 @@ class WavExport : public ExportInstance
 {
 public:
 
-    WavExport() = default;
+    WavExport()
+    {
+        // samples of all channels are interleaved, the iterators advance together
+        setSharedDataSetEnabled(true);
+    }
 
     static odk::RegisterExport getExportInfo()
     {
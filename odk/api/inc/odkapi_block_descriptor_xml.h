@@ -6,6 +6,7 @@
 #include "odkuni_defines.h"
 
 #include <map>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -48,6 +49,66 @@ namespace odk
         std::vector<BlockChannelDescriptor> m_block_channels;
     };
 
+    /**
+     * Parses block descriptors without building a XML document
+     *
+     * Consecutive block descriptors of a data stream usually only differ in their attribute values.
+     * The first descriptor of a structure is parsed by BlockDescriptor::parse and remembered as template,
+     * following descriptors with the same structure are decoded by scanning their attribute values.
+     * Descriptors with a different structure replace the template.
+     */
+    class BlockDescriptorCache
+    {
+    public:
+        BlockDescriptorCache() noexcept;
+
+        bool parse(const std::string_view& xml_string, BlockDescriptor& block_descriptor);
+
+        void clear() noexcept;
+
+        /// True if the last call to parse was served from the template
+        ODK_NODISCARD bool lastParseCached() const noexcept { return m_last_parse_cached; }
+
+    private:
+        enum class Field : std::uint8_t
+        {
+            NONE,
+            STREAM_ID,
+            DATA_SIZE,
+            CHANNEL_ID,
+            OFFSET,
+            COUNT,
+            FIRST_SAMPLE_INDEX,
+            TIMESTAMP,
+            DURATION
+        };
+
+        struct FieldMapping
+        {
+            Field m_field;
+            std::uint32_t m_channel_index;
+        };
+
+        struct ScannedValue
+        {
+            std::size_t m_element_index;
+            std::string_view m_element;
+            std::string_view m_attribute;
+            std::string_view m_value;
+        };
+
+        static std::uint64_t scan(const std::string_view& xml_string, std::vector<ScannedValue>& values);
+        bool learn(const std::string_view& xml_string, std::uint64_t structure_hash, BlockDescriptor& block_descriptor);
+        bool apply(BlockDescriptor& block_descriptor) const;
+
+        bool m_valid;
+        bool m_last_parse_cached;
+        std::uint64_t m_structure_hash;
+        std::size_t m_channel_count;
+        std::vector<FieldMapping> m_fields;
+        std::vector<ScannedValue> m_values;
+    };
+
     class DataRegion
     {
     public:
@@ -70,6 +131,9 @@ namespace odk
 
         std::vector<Interval<double>> m_windows;
         std::vector<DataRegion> m_invalid_regions;
+
+        /// valid data regions of the requested window, only sent by the host if PluginDataRequest::m_include_data_regions was set
+        std::optional<std::vector<DataRegion>> m_data_regions;
     };
 
     class DataRegions
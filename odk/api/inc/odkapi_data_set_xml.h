@@ -81,6 +81,9 @@ namespace odk
         std::optional<SingleValue> m_single_value;
         std::optional<DataStream> m_data_stream;
 
+        /// asks the host to return the valid data regions of the window in BlockListDescriptor::m_data_regions
+        std::optional<bool> m_include_data_regions;
+
     };
 
     class PluginDataStartRequest
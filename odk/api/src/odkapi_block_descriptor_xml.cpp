@@ -6,6 +6,8 @@
 #include "odkuni_string_util.h"
 #include "odkuni_xpugixml.h"
 
+#include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <sstream>
 
@@ -84,6 +86,251 @@ namespace odk
         return stream.str();
     }
 
+    namespace
+    {
+        bool parseUnsigned(const std::string_view& value, std::uint64_t& result)
+        {
+            const char* const end = value.data() + value.size();
+            const auto status = std::from_chars(value.data(), end, result);
+            return status.ec == std::errc() && status.ptr == end;
+        }
+
+        bool isNameChar(char c)
+        {
+            return c != '=' && c != '<' && c != '>' && c != '/' && c != '"' && c != '\''
+                && c != ' ' && c != '\t' && c != '\r' && c != '\n';
+        }
+
+        bool equalChannels(const BlockChannelDescriptor& lhs, const BlockChannelDescriptor& rhs)
+        {
+            return lhs.m_channel_id == rhs.m_channel_id
+                && lhs.m_offset == rhs.m_offset
+                && lhs.m_count == rhs.m_count
+                && lhs.m_first_sample_index == rhs.m_first_sample_index
+                && lhs.m_timestamp == rhs.m_timestamp
+                && lhs.m_duration == rhs.m_duration;
+        }
+    }
+
+    BlockDescriptorCache::BlockDescriptorCache() noexcept
+        : m_valid(false)
+        , m_last_parse_cached(false)
+        , m_structure_hash(0)
+        , m_channel_count(0)
+    {
+    }
+
+    bool BlockDescriptorCache::parse(const std::string_view& xml_string, BlockDescriptor& block_descriptor)
+    {
+        m_last_parse_cached = false;
+        if (xml_string.empty())
+        {
+            return false;
+        }
+
+        const auto structure_hash = scan(xml_string, m_values);
+        if (m_valid && structure_hash == m_structure_hash && m_values.size() == m_fields.size())
+        {
+            if (apply(block_descriptor))
+            {
+                m_last_parse_cached = true;
+                return true;
+            }
+        }
+        return learn(xml_string, structure_hash, block_descriptor);
+    }
+
+    void BlockDescriptorCache::clear() noexcept
+    {
+        m_valid = false;
+        m_last_parse_cached = false;
+        m_structure_hash = 0;
+        m_channel_count = 0;
+        m_fields.clear();
+        m_values.clear();
+    }
+
+    std::uint64_t BlockDescriptorCache::scan(const std::string_view& xml_string, std::vector<ScannedValue>& values)
+    {
+        // FNV-1a hash over everything except attribute values
+        std::uint64_t hash = 14695981039346656037ull;
+        auto hash_char = [&hash](char c)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 1099511628211ull;
+        };
+
+        values.clear();
+        std::size_t element_index = 0;
+        std::string_view element;
+        bool in_tag = false;
+
+        const std::size_t size = xml_string.size();
+        std::size_t pos = 0;
+        while (pos < size)
+        {
+            const char c = xml_string[pos];
+            if (!in_tag)
+            {
+                hash_char(c);
+                if (c == '<')
+                {
+                    in_tag = true;
+                    const std::size_t name_begin = pos + 1;
+                    std::size_t name_end = name_begin;
+                    while (name_end < size && isNameChar(xml_string[name_end]))
+                    {
+                        ++name_end;
+                    }
+                    element = xml_string.substr(name_begin, name_end - name_begin);
+                    ++element_index;
+                }
+                ++pos;
+            }
+            else if (c == '"' || c == '\'')
+            {
+                hash_char(c);
+                const std::size_t value_end = xml_string.find(c, pos + 1);
+                if (value_end == std::string_view::npos)
+                {
+                    // unterminated value, keep the hash unique to this input
+                    hash_char(static_cast<char>(size));
+                    break;
+                }
+
+                // attribute name precedes the value as name="value" (whitespace around '=' allowed)
+                std::size_t name_end = pos;
+                while (name_end > 0 && !isNameChar(xml_string[name_end - 1]))
+                {
+                    --name_end;
+                }
+                std::size_t name_begin = name_end;
+                while (name_begin > 0 && isNameChar(xml_string[name_begin - 1]))
+                {
+                    --name_begin;
+                }
+
+                values.push_back({element_index, element,
+                    xml_string.substr(name_begin, name_end - name_begin),
+                    xml_string.substr(pos + 1, value_end - pos - 1)});
+
+                hash_char(c);
+                pos = value_end + 1;
+            }
+            else
+            {
+                hash_char(c);
+                if (c == '>')
+                {
+                    in_tag = false;
+                }
+                ++pos;
+            }
+        }
+        return hash;
+    }
+
+    bool BlockDescriptorCache::learn(const std::string_view& xml_string, std::uint64_t structure_hash, BlockDescriptor& block_descriptor)
+    {
+        m_valid = false;
+        if (!block_descriptor.parse(xml_string))
+        {
+            return false;
+        }
+
+        m_fields.clear();
+        m_fields.reserve(m_values.size());
+        m_channel_count = 0;
+        std::size_t channel_element_index = 0;
+        for (const auto& value : m_values)
+        {
+            FieldMapping mapping = {Field::NONE, 0};
+            if (value.m_element == "BlockDescriptor")
+            {
+                if (value.m_attribute == "stream_id") mapping.m_field = Field::STREAM_ID;
+                else if (value.m_attribute == "data_size") mapping.m_field = Field::DATA_SIZE;
+            }
+            else if (value.m_element == "Channel")
+            {
+                if (value.m_element_index != channel_element_index)
+                {
+                    channel_element_index = value.m_element_index;
+                    ++m_channel_count;
+                }
+                mapping.m_channel_index = static_cast<std::uint32_t>(m_channel_count - 1);
+
+                if (value.m_attribute == "channel_id") mapping.m_field = Field::CHANNEL_ID;
+                else if (value.m_attribute == "offset") mapping.m_field = Field::OFFSET;
+                else if (value.m_attribute == "count") mapping.m_field = Field::COUNT;
+                else if (value.m_attribute == "first_sample_index") mapping.m_field = Field::FIRST_SAMPLE_INDEX;
+                else if (value.m_attribute == "timestamp") mapping.m_field = Field::TIMESTAMP;
+                else if (value.m_attribute == "duration") mapping.m_field = Field::DURATION;
+            }
+            m_fields.push_back(mapping);
+        }
+
+        // only use the template if it reproduces the result of the XML parser
+        BlockDescriptor check;
+        m_valid = true;
+        if (!apply(check)
+            || check.m_stream_id != block_descriptor.m_stream_id
+            || check.m_data_size != block_descriptor.m_data_size
+            || check.m_block_channels.size() != block_descriptor.m_block_channels.size()
+            || !std::equal(check.m_block_channels.begin(), check.m_block_channels.end(),
+                           block_descriptor.m_block_channels.begin(), equalChannels))
+        {
+            m_valid = false;
+        }
+        m_structure_hash = structure_hash;
+        return true;
+    }
+
+    bool BlockDescriptorCache::apply(BlockDescriptor& block_descriptor) const
+    {
+        block_descriptor.m_stream_id = 0;
+        block_descriptor.m_data_size = 0;
+        block_descriptor.m_block_channels.assign(m_channel_count, BlockChannelDescriptor());
+
+        for (std::size_t i = 0; i < m_fields.size(); ++i)
+        {
+            const auto& mapping = m_fields[i];
+            if (mapping.m_field == Field::NONE)
+            {
+                continue;
+            }
+
+            std::uint64_t number = 0;
+            if (!parseUnsigned(m_values[i].m_value, number))
+            {
+                return false;
+            }
+
+            if (mapping.m_field == Field::STREAM_ID)
+            {
+                block_descriptor.m_stream_id = number;
+                continue;
+            }
+            if (mapping.m_field == Field::DATA_SIZE)
+            {
+                block_descriptor.m_data_size = number;
+                continue;
+            }
+
+            auto& channel = block_descriptor.m_block_channels[mapping.m_channel_index];
+            switch (mapping.m_field)
+            {
+                case Field::CHANNEL_ID:         channel.m_channel_id = number; break;
+                case Field::OFFSET:             channel.m_offset = static_cast<std::uint32_t>(number); break;
+                case Field::COUNT:              channel.m_count = number; break;
+                case Field::FIRST_SAMPLE_INDEX: channel.m_first_sample_index = number; break;
+                case Field::TIMESTAMP:          channel.m_timestamp = number; break;
+                case Field::DURATION:           channel.m_duration = number; break;
+                default:                        break;
+            }
+        }
+        return true;
+    }
+
     DataRegion::DataRegion(std::uint64_t channel_id, const Interval<std::uint64_t>& region)
         : m_channel_id(channel_id)
         , m_region(region)
@@ -99,6 +346,8 @@ namespace odk
     bool BlockListDescriptor::parse(const std::string_view& xml_string)
     {
         m_windows.clear();
+        m_invalid_regions.clear();
+        m_data_regions.reset();
 
         if (xml_string.empty())
             return false;
@@ -133,6 +382,18 @@ namespace odk
                     auto end = odk::from_string<uint64_t>(a_region_detail_node.attribute("end").value());
                     m_invalid_regions.emplace_back(channel_id, Interval<uint64_t>(begin, end));
                 }
+
+                if (auto data_regions_node = block_list_desc_node.child("DataRegions"))
+                {
+                    m_data_regions.emplace();
+                    for (auto a_region_node : data_regions_node.children("DataRegion"))
+                    {
+                        auto channel_id = odk::from_string<uint64_t>(a_region_node.attribute("channel_id").value());
+                        auto begin = odk::from_string<uint64_t>(a_region_node.attribute("begin").value());
+                        auto end = odk::from_string<uint64_t>(a_region_node.attribute("end").value());
+                        m_data_regions->emplace_back(channel_id, Interval<uint64_t>(begin, end));
+                    }
+                }
             }
             catch (const std::logic_error&)
             {
@@ -173,6 +434,18 @@ namespace odk
                     }
                 }
             }
+
+            if (m_data_regions)
+            {
+                auto regions_node = block_list_desc_node.append_child("DataRegions");
+                for (const auto& a_region : *m_data_regions)
+                {
+                    regions_node.append_child("DataRegion",
+                        Attribute("channel_id", a_region.m_channel_id),
+                        Attribute("begin", a_region.m_region.m_begin),
+                        Attribute("end", a_region.m_region.m_end));
+                }
+            }
         }
         return stream.str();
     }
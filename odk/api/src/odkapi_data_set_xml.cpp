@@ -124,6 +124,11 @@ namespace odk
                 auto data_request_node = doc.document_element();
                 m_id = odk::from_string<std::uint64_t>(data_request_node.attribute("data_set_key").value());
 
+                if (auto include_regions_attr = data_request_node.attribute("include_data_regions"))
+                {
+                    m_include_data_regions = include_regions_attr.as_bool();
+                }
+
                 if(auto window_node = data_request_node.child("Window"))
                 {
                     m_data_window = DataWindow(
@@ -159,6 +164,10 @@ namespace odk
             odk::xml_builder::Document doc(stream);
             auto data_request_node = doc.append_child("DataTransferRequest",
                 Attribute("data_set_key", m_id));
+            if (m_include_data_regions)
+            {
+                data_request_node.append_attribute("include_data_regions", *m_include_data_regions);
+            }
 
             if (m_data_window)
             {
@@ -70,30 +70,43 @@ namespace odk
         return time;
     }
 
-    void addSamples(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp, const void* data, size_t data_size)
+    namespace
     {
-        const std::uint8_t* timestamp_bytes = reinterpret_cast<const std::uint8_t*>(&timestamp);
-        const std::uint8_t* data_bytes = reinterpret_cast<const std::uint8_t*>(data);
+        void sendSample(odk::IfHost* host, odk::MessageId msg_id, std::uint32_t local_channel_id, std::uint64_t timestamp, const void* data, size_t data_size)
+        {
+            // small samples are assembled on the stack, avoiding a heap allocation per call
+            constexpr std::size_t STACK_SAMPLE_SIZE = 256;
+            const auto sample_size = sizeof(std::uint64_t) + data_size;
+            if (sample_size <= STACK_SAMPLE_SIZE)
+            {
+                std::array<std::uint8_t, STACK_SAMPLE_SIZE> sample;
+                std::memcpy(sample.data(), &timestamp, sizeof(std::uint64_t));
+                std::memcpy(sample.data() + sizeof(std::uint64_t), data, data_size);
+                host->messageSyncData(msg_id, local_channel_id, sample.data(), sample_size, nullptr);
+            }
+            else
+            {
+                const std::uint8_t* timestamp_bytes = reinterpret_cast<const std::uint8_t*>(&timestamp);
+                const std::uint8_t* data_bytes = reinterpret_cast<const std::uint8_t*>(data);
 
-        std::vector<std::uint8_t> sample;
-        sample.reserve(sizeof(std::uint64_t) + data_size); // reserve but do not fill with 0
-        sample.insert(sample.end(), timestamp_bytes, timestamp_bytes + sizeof(std::uint64_t));
-        sample.insert(sample.end(), data_bytes, data_bytes + data_size);
+                std::vector<std::uint8_t> sample;
+                sample.reserve(sample_size); // reserve but do not fill with 0
+                sample.insert(sample.end(), timestamp_bytes, timestamp_bytes + sizeof(std::uint64_t));
+                sample.insert(sample.end(), data_bytes, data_bytes + data_size);
 
-        host->messageSyncData(odk::host_msg::ADD_CONTIGUOUS_SAMPLES, local_channel_id, sample.data(), sample.size(), nullptr);
+                host->messageSyncData(msg_id, local_channel_id, sample.data(), sample.size(), nullptr);
+            }
+        }
     }
 
-    void addSample(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp, const void* data, size_t data_size)
+    void addSamples(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp, const void* data, size_t data_size)
     {
-        const std::uint8_t* timestamp_bytes = reinterpret_cast<const std::uint8_t*>(&timestamp);
-        const std::uint8_t* data_bytes = reinterpret_cast<const std::uint8_t*>(data);
-
-        std::vector<std::uint8_t> sample;
-        sample.reserve(sizeof(std::uint64_t) + data_size); // reserve but do not fill with 0
-        sample.insert(sample.end(), timestamp_bytes, timestamp_bytes + sizeof(std::uint64_t));
-        sample.insert(sample.end(), data_bytes, data_bytes + data_size);
+        sendSample(host, odk::host_msg::ADD_CONTIGUOUS_SAMPLES, local_channel_id, timestamp, data, data_size);
+    }
 
-        host->messageSyncData(odk::host_msg::ADD_SAMPLE, local_channel_id, sample.data(), sample.size(), nullptr);
+    void addSample(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp, const void* data, size_t data_size)
+    {
+        sendSample(host, odk::host_msg::ADD_SAMPLE, local_channel_id, timestamp, data, data_size);
     }
 
     void updateChannelState(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp)
@@ -65,4 +65,101 @@ BOOST_AUTO_TEST_CASE(parse_generate)
     BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_duration, 300);
 }
 
+BOOST_AUTO_TEST_CASE(block_descriptor_cache)
+{
+    auto make_descriptor = [](std::uint64_t first_sample_index, std::uint64_t count, std::size_t channels)
+    {
+        BlockDescriptor block_descriptor(3, 1024);
+        for (std::size_t i = 0; i < channels; ++i)
+        {
+            BlockChannelDescriptor bcd;
+            bcd.m_channel_id = 10 + i;
+            bcd.m_offset = static_cast<std::uint32_t>(64 * i);
+            bcd.m_first_sample_index = first_sample_index;
+            bcd.m_count = count;
+            bcd.m_timestamp = first_sample_index;
+            bcd.m_duration = count;
+            block_descriptor.m_block_channels.push_back(bcd);
+        }
+        return block_descriptor.generate();
+    };
+
+    BlockDescriptorCache cache;
+    BlockDescriptor block_descriptor;
+
+    BOOST_CHECK(!cache.parse("", block_descriptor));
+
+    BOOST_CHECK(cache.parse(make_descriptor(0, 100, 2), block_descriptor));
+    BOOST_CHECK(!cache.lastParseCached());
+    BOOST_REQUIRE_EQUAL(block_descriptor.m_block_channels.size(), 2);
+    BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_count, 100);
+
+    for (std::uint64_t i = 1; i < 5; ++i)
+    {
+        BOOST_CHECK(cache.parse(make_descriptor(i * 12345, 100 + i, 2), block_descriptor));
+        BOOST_CHECK(cache.lastParseCached());
+        BOOST_CHECK_EQUAL(block_descriptor.m_stream_id, 3);
+        BOOST_CHECK_EQUAL(block_descriptor.m_data_size, 1024);
+        BOOST_REQUIRE_EQUAL(block_descriptor.m_block_channels.size(), 2);
+        BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_channel_id, 11);
+        BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_offset, 64);
+        BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_first_sample_index, i * 12345);
+        BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_timestamp, i * 12345);
+        BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_count, 100 + i);
+        BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(1).m_duration, 100 + i);
+    }
+
+    // a different structure replaces the template
+    BOOST_CHECK(cache.parse(make_descriptor(7, 8, 3), block_descriptor));
+    BOOST_CHECK(!cache.lastParseCached());
+    BOOST_REQUIRE_EQUAL(block_descriptor.m_block_channels.size(), 3);
+    BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(2).m_channel_id, 12);
+
+    BOOST_CHECK(cache.parse(make_descriptor(9, 8, 3), block_descriptor));
+    BOOST_CHECK(cache.lastParseCached());
+    BOOST_CHECK_EQUAL(block_descriptor.m_block_channels.at(2).m_first_sample_index, 9);
+}
+
+BOOST_AUTO_TEST_CASE(block_list_data_regions)
+{
+    const char* const xml_content =
+        R"xxx(<?xml version='1.0' encoding='UTF-8'?>
+            <BlockListDescriptor block_count="1">
+                <Intervals>
+                    <Interval begin="0.5" end="1.5" />
+                </Intervals>
+                <DataRegions>
+                    <DataRegion channel_id="1" begin="100" end="200" />
+                    <DataRegion channel_id="2" begin="150" end="300" />
+                </DataRegions>
+            </BlockListDescriptor>
+            )xxx"
+            ;
+
+    BlockListDescriptor block_list;
+    BOOST_CHECK(block_list.parse(xml_content));
+    BOOST_REQUIRE(block_list.m_data_regions);
+    BOOST_REQUIRE_EQUAL(block_list.m_data_regions->size(), 2);
+    BOOST_CHECK_EQUAL(block_list.m_data_regions->at(1).m_channel_id, 2);
+    BOOST_CHECK_EQUAL(block_list.m_data_regions->at(1).m_region.m_begin, 150);
+    BOOST_CHECK_EQUAL(block_list.m_data_regions->at(1).m_region.m_end, 300);
+
+    BOOST_CHECK(block_list.parse(block_list.generate()));
+    BOOST_REQUIRE(block_list.m_data_regions);
+    BOOST_REQUIRE_EQUAL(block_list.m_data_regions->size(), 2);
+    BOOST_CHECK_EQUAL(block_list.m_data_regions->at(0).m_channel_id, 1);
+    BOOST_CHECK_EQUAL(block_list.m_data_regions->at(0).m_region.m_begin, 100);
+    BOOST_CHECK_EQUAL(block_list.m_data_regions->at(0).m_region.m_end, 200);
+
+    // an empty list is different from regions that were not sent
+    block_list.m_data_regions->clear();
+    BOOST_CHECK(block_list.parse(block_list.generate()));
+    BOOST_REQUIRE(block_list.m_data_regions);
+    BOOST_CHECK(block_list.m_data_regions->empty());
+
+    block_list.m_data_regions.reset();
+    BOOST_CHECK(block_list.parse(block_list.generate()));
+    BOOST_CHECK(!block_list.m_data_regions);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -152,6 +152,20 @@ BOOST_AUTO_TEST_CASE(parse_generate_parse_data_request)
     BOOST_CHECK_EQUAL(data_request.m_data_window->m_stop, 12.34);
 }
 
+BOOST_AUTO_TEST_CASE(parse_generate_parse_data_request_include_data_regions)
+{
+    PluginDataRequest data_request(418, PluginDataRequest::DataWindow(1.0, 2.0));
+    BOOST_CHECK(!data_request.m_include_data_regions);
+
+    data_request.m_include_data_regions = true;
+    PluginDataRequest parsed_request;
+    BOOST_CHECK(parsed_request.parse(data_request.generate()));
+    BOOST_CHECK_EQUAL(parsed_request.m_id, 418);
+    BOOST_REQUIRE(parsed_request.m_data_window);
+    BOOST_REQUIRE(parsed_request.m_include_data_regions);
+    BOOST_CHECK(*parsed_request.m_include_data_regions);
+}
+
 BOOST_AUTO_TEST_CASE(parse_generate_parse_data_request_single_value)
 {
     const char* const xml_content =
@@ -13,6 +13,41 @@ ODK_NODISCARD inline double convertTickToTimeOld(std::uint64_t tick, double freq
     return std::nextafter(tick / frequency, std::numeric_limits<double>::max());
 }
 
+namespace
+{
+    class SampleRecorderHost : public odk::IfHost
+    {
+    public:
+        struct Message
+        {
+            odk::MessageId m_msg_id;
+            std::uint64_t m_key;
+            std::uint64_t m_timestamp;
+            std::vector<double> m_values;
+        };
+
+        odk::IfValue* PLUGIN_API createValue(odk::IfValue::Type) const override { return nullptr; }
+        std::uint64_t PLUGIN_API messageSync(odk::MessageId, std::uint64_t, const odk::IfValue*, const odk::IfValue**) override { return 0; }
+        std::uint64_t PLUGIN_API messageAsync(odk::MessageId, std::uint64_t, const odk::IfValue*) override { return 0; }
+        const odk::IfValue* PLUGIN_API query(const char*, const char*, const odk::IfValue*) override { return nullptr; }
+        const odk::IfValue* PLUGIN_API queryXML(const char*, const char*, const char*, std::uint64_t) override { return nullptr; }
+
+        std::uint64_t PLUGIN_API messageSyncData(odk::MessageId msg_id, std::uint64_t key, const void* param, std::uint64_t param_size, const odk::IfValue**) override
+        {
+            BOOST_REQUIRE_GE(param_size, sizeof(std::uint64_t));
+            Message message{msg_id, key, 0, {}};
+            const auto bytes = static_cast<const std::uint8_t*>(param);
+            std::memcpy(&message.m_timestamp, bytes, sizeof(std::uint64_t));
+            message.m_values.resize((param_size - sizeof(std::uint64_t)) / sizeof(double));
+            std::memcpy(message.m_values.data(), bytes + sizeof(std::uint64_t), message.m_values.size() * sizeof(double));
+            m_messages.push_back(message);
+            return 0;
+        }
+
+        std::vector<Message> m_messages;
+    };
+}
+
 std::uint64_t convertTickToTimeToTick(std::uint64_t tick, double frequency)
 {
     //auto tm = convertTickToTimeOld(tick, frequency);
@@ -70,4 +105,23 @@ BOOST_AUTO_TEST_CASE(convert_timestamp_to_tick_test)
     BOOST_CHECK_EQUAL(1233 / 2, convertTimestampToTick(odk::Timestamp(1233, 100.0), 50.0));
 }
 
+BOOST_AUTO_TEST_CASE(add_samples_test)
+{
+    SampleRecorderHost host;
+    const std::vector<double> values(100, 1.5);
+    addSamples(&host, 3, 10, values.data(), 2 * sizeof(double));
+    addSample(&host, 3, 20, values.data(), values.size() * sizeof(double));
+    addSample(&host, 3, 30, 2.5);
+
+    BOOST_REQUIRE_EQUAL(host.m_messages.size(), 3);
+    BOOST_CHECK(host.m_messages[0].m_msg_id == odk::host_msg::ADD_CONTIGUOUS_SAMPLES);
+    BOOST_CHECK_EQUAL(host.m_messages[0].m_timestamp, 10);
+    BOOST_CHECK_EQUAL(host.m_messages[0].m_values.size(), 2);
+    BOOST_CHECK(host.m_messages[1].m_msg_id == odk::host_msg::ADD_SAMPLE);
+    BOOST_CHECK_EQUAL(host.m_messages[1].m_values.size(), values.size());
+    BOOST_CHECK_EQUAL(host.m_messages[2].m_timestamp, 30);
+    BOOST_REQUIRE_EQUAL(host.m_messages[2].m_values.size(), 1);
+    BOOST_CHECK_EQUAL(host.m_messages[2].m_values[0], 2.5);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
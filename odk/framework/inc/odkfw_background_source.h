@@ -0,0 +1,243 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+#define ODK_EXTENSION_FUNCTIONS //enable C++ integration
+
+#include "odkapi_utils.h"
+#include "odkfw_software_channel_instance.h"
+#include "odkuni_defines.h"
+#include "odkuni_logger.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Base class for source channels that read their data on a background thread
+     *
+     * A producer thread fills a fixed number of blocks ahead of the acquisition, e.g. from a file,
+     * process() hands the filled blocks to emitBlock() until the master timestamp is reached.
+     * When all blocks are filled the producer waits until process() has emitted one (back-pressure),
+     * so memory stays constant regardless of the amount of data replayed.
+     * If the producer falls behind, the samples are emitted as soon as they are available.
+     *
+     * The producer is started in prepareProcessing() and stopped in stopProcessing().
+     * Derived classes have to call stopProducer() in their destructor, produceBlock() must not run
+     * while the derived object is destroyed.
+     */
+    template <class Block>
+    class BackgroundSourceInstance : public SoftwareChannelInstance
+    {
+    public:
+        explicit BackgroundSourceInstance(std::size_t max_queued_blocks = 4)
+            : m_blocks(std::max<std::size_t>(max_queued_blocks, 1))
+            , m_write_count(0)
+            , m_read_count(0)
+            , m_stop(false)
+            , m_producing(false)
+        {
+        }
+
+        ~BackgroundSourceInstance()
+        {
+            stopThread();
+        }
+
+        void prepareProcessing(odk::IfHost* host) override
+        {
+            const auto ts = getMasterTimestamp(host);
+            std::uint64_t first_tick = 0;
+            if (ts.m_frequency > 0.0)
+            {
+                first_tick = static_cast<std::uint64_t>(ts.m_ticks * (getSourceFrequency() / ts.m_frequency));
+            }
+            startProducer(first_tick);
+        }
+
+        void stopProcessing(odk::IfHost* host) override
+        {
+            ODK_UNUSED(host);
+            stopProducer();
+        }
+
+        void process(ProcessingContext& context, odk::IfHost* host) override
+        {
+            const auto& ts = context.m_master_timestamp;
+            if (ts.m_frequency <= 0.0)
+            {
+                return;
+            }
+            const auto target_tick = static_cast<std::uint64_t>(ts.m_ticks * (getSourceFrequency() / ts.m_frequency));
+
+            while (Block* block = getFilledBlock())
+            {
+                if (!emitBlock(*block, target_tick, host))
+                {
+                    break;
+                }
+                releaseBlock();
+            }
+        }
+
+        /**
+         * @return true while the producer thread is running or filled blocks are left to emit
+         */
+        ODK_NODISCARD bool isProducing() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_producing || m_read_count != m_write_count;
+        }
+
+    protected:
+        /**
+         * Frequency of the ticks passed to startProducing() and emitBlock()
+         */
+        virtual double getSourceFrequency() const = 0;
+
+        /**
+         * Called before the producer thread is started, e.g. to open and seek the input
+         * @param first_tick tick of the master timestamp at the start of processing
+         * @return false if there is nothing to produce
+         */
+        virtual bool startProducing(std::uint64_t first_tick) = 0;
+
+        /**
+         * Called on the producer thread to fill the next block, the block is reused after it has been emitted
+         * @return false if the end of the data has been reached, the block is discarded then
+         */
+        virtual bool produceBlock(Block& block) = 0;
+
+        /**
+         * Called after the producer thread has been stopped, e.g. to close the input
+         */
+        virtual void stopProducing() {}
+
+        /**
+         * Called in process() to send the samples of block up to (excluding) target_tick
+         * @return true if the block has been sent completely and can be reused by the producer
+         */
+        virtual bool emitBlock(Block& block, std::uint64_t target_tick, odk::IfHost* host) = 0;
+
+        void startProducer(std::uint64_t first_tick)
+        {
+            stopProducer();
+
+            m_write_count = 0;
+            m_read_count = 0;
+            m_stop = false;
+            if (startProducing(first_tick))
+            {
+                m_producing = true;
+                m_thread = std::thread(&BackgroundSourceInstance::produce, this);
+            }
+        }
+
+        void stopProducer()
+        {
+            if (stopThread())
+            {
+                stopProducing();
+            }
+            m_write_count = 0;
+            m_read_count = 0;
+        }
+
+    private:
+        bool stopThread()
+        {
+            if (!m_thread.joinable())
+            {
+                return false;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_changed.notify_all();
+            m_thread.join();
+            return true;
+        }
+
+        void produce()
+        {
+            while (true)
+            {
+                std::size_t index;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_changed.wait(lock, [this] { return m_stop || m_write_count - m_read_count < m_blocks.size(); });
+                    if (m_stop)
+                    {
+                        m_producing = false;
+                        return;
+                    }
+                    index = m_write_count % m_blocks.size();
+                }
+
+                // the block is neither read by process() nor handed out until m_write_count is incremented
+                bool produced = false;
+                try
+                {
+                    produced = produceBlock(m_blocks[index]);
+                }
+                catch (const std::exception& e)
+                {
+                    ODK_UNUSED(e);
+                    ODKLOG_ERROR("Unhandled exception in 'produceBlock': " << e.what());
+                }
+                catch (...)
+                {
+                    ODKLOG_ERROR("Unhandled exception in 'produceBlock'");
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!produced)
+                {
+                    m_producing = false;
+                    return;
+                }
+                ++m_write_count;
+            }
+        }
+
+        Block* getFilledBlock()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_read_count == m_write_count)
+            {
+                return nullptr;
+            }
+            return &m_blocks[m_read_count % m_blocks.size()];
+        }
+
+        void releaseBlock()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_read_count;
+            }
+            m_changed.notify_all();
+        }
+
+        /// blocks are filled and emitted in ring order, m_write_count - m_read_count of them are filled
+        std::vector<Block> m_blocks;
+        std::size_t m_write_count;
+        std::size_t m_read_count;
+        bool m_stop;
+        bool m_producing;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_changed;
+        std::thread m_thread;
+    };
+}
+}
@@ -9,6 +9,16 @@ namespace odk
 {
 namespace framework
 {
+    /**
+     * Memory layout of the samples of a block
+     */
+    enum class BlockLayout
+    {
+        IMPLICIT_TIMESTAMP, ///< static sample size, timestamp incremented every sample (SYNC data and gaps)
+        EXPLICIT_TIMESTAMP, ///< static sample size, timestamp stored with every sample
+        DYNAMIC_SIZE        ///< timestamp and sample size stored with every sample
+    };
+
     class BlockIterator
     {
     public:
@@ -24,10 +34,34 @@ namespace framework
         ODK_NODISCARD inline std::uint64_t timestamp() const noexcept { return m_timestamp ? *m_timestamp : m_timestamp_value;}
         /// Dynamic sample size of the sample (0 if it has a static size)
         ODK_NODISCARD inline std::size_t size() const noexcept { return m_sample_size ? *m_sample_size : m_sample_size_value; }
+        /// Distance in bytes between the start addresses of two consecutive samples (excluding a dynamic sample size)
+        ODK_NODISCARD inline std::size_t stride() const noexcept { return m_data_stride; }
+        /// True if every sample carries its own size field
+        ODK_NODISCARD inline bool hasDynamicSize() const noexcept { return m_sample_size != nullptr; }
+
+        ODK_NODISCARD inline BlockLayout layout() const noexcept
+        {
+            if (m_sample_size)
+            {
+                return BlockLayout::DYNAMIC_SIZE;
+            }
+            return m_timestamp ? BlockLayout::EXPLICIT_TIMESTAMP : BlockLayout::IMPLICIT_TIMESTAMP;
+        }
+
+        /**
+         * Advances the iterator by one sample assuming the given layout
+         * Layout has to match layout(), no runtime checks are done
+         */
+        template<BlockLayout Layout>
+        inline void increment() noexcept;
+
+        inline BlockIterator& operator++() noexcept;
 
-        BlockIterator& operator++();
         BlockIterator& operator--();
 
+        /// Advances the iterator by count samples (constant time for samples with static size)
+        BlockIterator& operator+=(std::uint64_t count);
+
         ODK_NODISCARD inline bool operator==(const BlockIterator& other) const noexcept
         {
             return m_data && other.m_data ?
@@ -74,5 +108,43 @@ namespace framework
             std::size_t m_sample_size_value;
         };
     };
+
+    template<>
+    inline void BlockIterator::increment<BlockLayout::IMPLICIT_TIMESTAMP>() noexcept
+    {
+        // gaps have no data and a stride of zero
+        m_data = reinterpret_cast<const std::uint8_t*>(m_data) + m_data_stride;
+        ++m_timestamp_value;
+    }
+
+    template<>
+    inline void BlockIterator::increment<BlockLayout::EXPLICIT_TIMESTAMP>() noexcept
+    {
+        m_data = reinterpret_cast<const std::uint8_t*>(m_data) + m_data_stride;
+        m_timestamp = reinterpret_cast<const std::uint64_t*>(
+            reinterpret_cast<const std::uint8_t*>(m_timestamp) + m_timestamp_stride);
+    }
+
+    template<>
+    inline void BlockIterator::increment<BlockLayout::DYNAMIC_SIZE>() noexcept
+    {
+        const std::size_t sample_size = *m_sample_size;
+        m_data = reinterpret_cast<const std::uint8_t*>(m_data) + m_data_stride + sample_size;
+        m_timestamp = reinterpret_cast<const std::uint64_t*>(
+            reinterpret_cast<const std::uint8_t*>(m_timestamp) + m_timestamp_stride + sample_size);
+        m_sample_size = reinterpret_cast<const std::uint32_t*>(
+            reinterpret_cast<const std::uint8_t*>(m_sample_size) + m_sample_size_stride + sample_size);
+    }
+
+    inline BlockIterator& BlockIterator::operator++() noexcept
+    {
+        switch (layout())
+        {
+            case BlockLayout::IMPLICIT_TIMESTAMP: increment<BlockLayout::IMPLICIT_TIMESTAMP>(); break;
+            case BlockLayout::EXPLICIT_TIMESTAMP: increment<BlockLayout::EXPLICIT_TIMESTAMP>(); break;
+            case BlockLayout::DYNAMIC_SIZE:       increment<BlockLayout::DYNAMIC_SIZE>(); break;
+        }
+        return *this;
+    }
 }
 }
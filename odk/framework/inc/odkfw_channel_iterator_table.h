@@ -0,0 +1,102 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+
+#include "odkfw_stream_iterator.h"
+#include "odkuni_defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Stream iterators of the input channels stored in a flat table
+     * every channel gets a slot index when it is added, slots stay valid until clear() is called.
+     * Plugins can resolve the slot of a channel once and access its iterator by index afterwards.
+     * Access by channel id mirrors the std::map interface that was used before, except that operator[]
+     * does not add channels: adding could move the iterators other code holds references to.
+     */
+    class ChannelIteratorTable
+    {
+    public:
+        using value_type = std::pair<const std::uint64_t, StreamIterator>;
+        using iterator = std::vector<value_type>::iterator;
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+        static constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Adds a channel with a default constructed iterator
+         * @return slot of the channel, the existing slot if the channel was already added
+         */
+        std::size_t addChannel(std::uint64_t channel_id);
+
+        /**
+         * Returns the slot of the channel or NO_SLOT
+         */
+        ODK_NODISCARD std::size_t getSlot(std::uint64_t channel_id) const noexcept;
+
+        ODK_NODISCARD StreamIterator& getIterator(std::size_t slot) noexcept
+        {
+            ODK_ASSERT(slot < m_entries.size());
+            return m_entries[slot].second;
+        }
+
+        ODK_NODISCARD const StreamIterator& getIterator(std::size_t slot) const noexcept
+        {
+            ODK_ASSERT(slot < m_entries.size());
+            return m_entries[slot].second;
+        }
+
+        ODK_NODISCARD std::uint64_t getChannelId(std::size_t slot) const noexcept
+        {
+            ODK_ASSERT(slot < m_entries.size());
+            return m_entries[slot].first;
+        }
+
+        /**
+         * Returns the iterator of the channel, same as at()
+         * channels are only added by addChannel() before processing starts
+         * @throws std::out_of_range if the channel is unknown
+         */
+        ODK_NODISCARD StreamIterator& operator[](std::uint64_t channel_id);
+        ODK_NODISCARD const StreamIterator& operator[](std::uint64_t channel_id) const;
+
+        /**
+         * Returns the iterator of the channel
+         * @throws std::out_of_range if the channel is unknown
+         */
+        ODK_NODISCARD StreamIterator& at(std::uint64_t channel_id);
+        ODK_NODISCARD const StreamIterator& at(std::uint64_t channel_id) const;
+
+        ODK_NODISCARD iterator find(std::uint64_t channel_id) noexcept;
+        ODK_NODISCARD const_iterator find(std::uint64_t channel_id) const noexcept;
+        ODK_NODISCARD std::size_t count(std::uint64_t channel_id) const noexcept;
+
+        ODK_NODISCARD std::size_t size() const noexcept { return m_entries.size(); }
+        ODK_NODISCARD bool empty() const noexcept { return m_entries.empty(); }
+
+        /// entries are visited in slot order
+        ODK_NODISCARD iterator begin() noexcept { return m_entries.begin(); }
+        ODK_NODISCARD iterator end() noexcept { return m_entries.end(); }
+        ODK_NODISCARD const_iterator begin() const noexcept { return m_entries.begin(); }
+        ODK_NODISCARD const_iterator end() const noexcept { return m_entries.end(); }
+
+        void clear() noexcept;
+
+    private:
+        using SlotIndex = std::vector<std::pair<std::uint64_t, std::size_t>>;
+
+        SlotIndex::const_iterator lowerBound(std::uint64_t channel_id) const noexcept;
+
+        std::vector<value_type> m_entries;
+        /// (channel id, slot) sorted by channel id
+        SlotIndex m_slot_index;
+    };
+}
+}
@@ -5,6 +5,7 @@
 
 #include "odkfw_interfaces.h"
 #include "odkfw_if_message_handler.h"
+#include "odkfw_parallel_task_executor.h"
 #include "odkfw_properties.h"
 
 #include "odkbase_if_host.h"
@@ -17,8 +18,12 @@
 #include "odkapi_oxygen_queries.h"
 #include "odkapi_update_channels_xml.h"
 
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
 
 
 
@@ -147,6 +152,8 @@ namespace framework
         std::vector<std::uint64_t> m_input_channels;
         std::vector<PluginChannelPtr> m_output_channels;
         bool m_registered;
+        /// the worker has been started as member of the task group and not stopped since (parallel processing only)
+        bool m_group_started;
 
         std::shared_ptr<IfTaskWorker> m_worker;
         std::uint64_t m_token;
@@ -179,6 +186,38 @@ namespace framework
         void pauseTasks();
         void pauseTask(PluginTaskPtr& task);
         void restartTask(PluginTaskPtr& task);
+
+        /**
+         * Processes all tasks concurrently on a thread pool
+         * all valid tasks are registered as a single acquisition task, its process call runs
+         * onProcess of every task as a separate job, host calls made through the host argument
+         * of onProcess are executed on the thread of the process call (@see ParallelTaskExecutor)
+         * the group uses the shortest block duration of all tasks and waits for the inputs of all of them,
+         * so this only suits plugins whose instances can run at a common rate
+         * restarting a task only restarts its worker, the group is registered again only if its channels change
+         * has to be enabled before any task is registered
+         *
+         * @param thread_count  number of worker threads, 0 uses one per hardware thread
+         */
+        void enableParallelProcessing(std::size_t thread_count = 0);
+
+        ODK_NODISCARD bool isParallelProcessingEnabled() const noexcept;
+
+        /**
+         * Thread pool of the plugin, the pool of the parallel processing if enabled
+         * otherwise created on first use with one thread per hardware thread
+         */
+        WorkStealingThreadPool& getThreadPool();
+
+        /**
+         * Stops and joins all worker threads, called from deinit of the plugin
+         * the threads must not be joined during static destruction, on Windows that runs under the loader lock of the DLL
+         */
+        void shutdownThreads();
+
+        /// id of the acquisition task that combines all tasks when parallel processing is enabled
+        static constexpr std::uint64_t TASK_GROUP_ID = std::numeric_limits<std::uint64_t>::max();
+
     private:
 
         std::set<PluginTaskPtr> getAffectedTasks(const odk::UpdateConfigTelegram& request);
@@ -216,6 +255,21 @@ namespace framework
         void registerTask(PluginTask& task);
         void unregisterTask(PluginTask& t);
 
+        /**
+         * Registers all tasks marked as registered as one acquisition task, replacing the previous one
+         * if its channels or block duration changed. Otherwise the group keeps running and only the workers
+         * that joined or left it are started or stopped.
+         *
+         * @return true if the group has been registered again
+         */
+        bool updateTaskGroup();
+
+        void stopGroupWorker(PluginTask& task);
+
+        std::vector<PluginTaskPtr> getGroupTasks() const;
+
+        std::uint64_t processTaskGroup(odk::PluginMessageId id, const odk::IfValue* param);
+
     private:
         odk::IfHost* m_host = nullptr;
 
@@ -230,6 +284,13 @@ namespace framework
 
         bool m_channels_dirty = false; //< channels added, removed or reconfigured
         std::set<const PluginChannel*> m_properties_dirty;
+
+        std::unique_ptr<ParallelTaskExecutor> m_executor; //< only set if parallel processing is enabled
+        std::unique_ptr<WorkStealingThreadPool> m_thread_pool; //< only set if used without parallel processing
+        std::mutex m_thread_pool_mutex;
+        bool m_task_group_registered = false;
+        bool m_task_group_running = false; //< between start and stop processing of the task group
+        std::string m_task_group_xml; //< telegram the task group has been registered with
     };
 
     template<class TargetClass>
@@ -0,0 +1,152 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+#define ODK_EXTENSION_FUNCTIONS //enable C++ integration
+
+#include "odkapi_message_ids.h"
+#include "odkbase_if_host.h"
+#include "odkuni_defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Sample buffer laid out as an odk::host_msg::ADD_CONTIGUOUS_SAMPLES payload:
+     * a leading uint64 timestamp slot followed by the samples.
+     * Samples are computed directly into the buffer and sent without another copy.
+     * The memory is kept across clear() and resize(), so the buffer can be reused for every process() call.
+     */
+    template <class T>
+    class ContiguousSampleBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Samples are sent as raw bytes");
+        static_assert(alignof(T) <= alignof(std::uint64_t), "Samples are stored behind a uint64 timestamp");
+
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        ContiguousSampleBuffer()
+            : m_storage(1)
+            , m_size(0)
+        {
+        }
+
+        explicit ContiguousSampleBuffer(std::size_t size)
+            : ContiguousSampleBuffer()
+        {
+            resize(size);
+        }
+
+        /**
+         * Changes the number of samples, new samples are value initialized
+         */
+        void resize(std::size_t size)
+        {
+            m_storage.resize(storageSize(size));
+            m_size = size;
+        }
+
+        void reserve(std::size_t size)
+        {
+            m_storage.reserve(storageSize(size));
+        }
+
+        void clear() noexcept
+        {
+            m_size = 0;
+        }
+
+        void push_back(const T& value)
+        {
+            if (storageSize(m_size + 1) > m_storage.size())
+            {
+                m_storage.resize(storageSize(m_size + 1));
+            }
+            data()[m_size++] = value;
+        }
+
+        ODK_NODISCARD std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        ODK_NODISCARD bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        ODK_NODISCARD T* data() noexcept
+        {
+            return reinterpret_cast<T*>(m_storage.data() + 1);
+        }
+
+        ODK_NODISCARD const T* data() const noexcept
+        {
+            return reinterpret_cast<const T*>(m_storage.data() + 1);
+        }
+
+        ODK_NODISCARD T& operator[](std::size_t index) noexcept
+        {
+            return data()[index];
+        }
+
+        ODK_NODISCARD const T& operator[](std::size_t index) const noexcept
+        {
+            return data()[index];
+        }
+
+        ODK_NODISCARD iterator begin() noexcept { return data(); }
+        ODK_NODISCARD iterator end() noexcept { return data() + m_size; }
+        ODK_NODISCARD const_iterator begin() const noexcept { return data(); }
+        ODK_NODISCARD const_iterator end() const noexcept { return data() + m_size; }
+
+        /**
+         * Returns the complete message payload: timestamp followed by the first count samples
+         */
+        ODK_NODISCARD const void* payload() const noexcept
+        {
+            return m_storage.data();
+        }
+
+        ODK_NODISCARD std::size_t payloadSize(std::size_t count) const noexcept
+        {
+            return sizeof(std::uint64_t) + count * sizeof(T);
+        }
+
+        /**
+         * Sends the first count samples starting at timestamp with odk::host_msg::ADD_CONTIGUOUS_SAMPLES
+         */
+        std::uint64_t send(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp, std::size_t count)
+        {
+            std::memcpy(m_storage.data(), &timestamp, sizeof(std::uint64_t));
+            return host->messageSyncData(odk::host_msg::ADD_CONTIGUOUS_SAMPLES, local_channel_id, payload(), payloadSize(count), nullptr);
+        }
+
+        /**
+         * Sends all samples starting at timestamp with odk::host_msg::ADD_CONTIGUOUS_SAMPLES
+         */
+        std::uint64_t send(odk::IfHost* host, std::uint32_t local_channel_id, std::uint64_t timestamp)
+        {
+            return send(host, local_channel_id, timestamp, m_size);
+        }
+
+    private:
+        static std::size_t storageSize(std::size_t size) noexcept
+        {
+            return 1 + (size * sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+        }
+
+        /// word 0 holds the timestamp, the samples follow
+        std::vector<std::uint64_t> m_storage;
+        std::size_t m_size;
+    };
+}
+}
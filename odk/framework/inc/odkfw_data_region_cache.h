@@ -0,0 +1,77 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+
+#include "odkapi_block_descriptor_xml.h"
+#include "odkuni_defines.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Valid data regions of a time interval, fetched once and looked up locally for every window
+     *
+     * Regions are kept per channel sorted by start, overlapping regions are merged,
+     * so looking up the regions of a window is a binary search per channel.
+     * Region bounds are sample ticks, lookups use seconds: the tick duration of every channel
+     * has to be set before regions are assigned, regions of other channels are dropped.
+     */
+    class DataRegionCache
+    {
+    public:
+        DataRegionCache() noexcept;
+
+        /**
+         * Sets the duration of one tick of the channel in seconds, e.g. 1 / sample rate
+         */
+        void setTickDuration(std::uint64_t channel_id, double tick_duration);
+
+        /**
+         * Replaces the cached regions by the valid regions of [start, end]
+         */
+        void assign(const std::vector<DataRegion>& regions, double start, double end);
+
+        /**
+         * Drops all regions and channels, tick durations have to be set again before the next assign
+         */
+        void clear();
+
+        /**
+         * @return true if the regions of [start, end] are cached
+         */
+        ODK_NODISCARD bool covers(double start, double end) const noexcept;
+
+        /**
+         * Returns all regions overlapping [start, end], sorted by channel and start
+         */
+        ODK_NODISCARD std::vector<DataRegion> getRegions(double start, double end) const;
+
+        /**
+         * Returns the regions of a single channel overlapping [start, end]
+         */
+        ODK_NODISCARD std::vector<DataRegion> getRegions(std::uint64_t channel_id, double start, double end) const;
+
+        /**
+         * Returns the earliest start (in seconds) of a region of any channel at or after position
+         */
+        ODK_NODISCARD std::optional<double> getNextRegionStart(double position) const;
+
+    private:
+        struct ChannelRegions
+        {
+            double m_tick_duration = 0.0;
+            std::vector<Interval<std::uint64_t>> m_regions;
+        };
+
+        static void appendRegions(std::uint64_t channel_id, const ChannelRegions& channel, double start, double end, std::vector<DataRegion>& regions);
+
+        std::map<std::uint64_t, ChannelRegions> m_channels;
+        std::optional<Interval<double>> m_interval;
+    };
+}
+}
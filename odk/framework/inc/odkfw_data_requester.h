@@ -3,18 +3,25 @@
 
 #define ODK_EXTENSION_FUNCTIONS
 
+#include "odkapi_block_descriptor_xml.h"
 #include "odkapi_data_set_xml.h"
 #include "odkapi_message_ids.h"
 #include "odkbase_message_return_value_holder.h"
 #include "odkbase_if_host.h"
 #include "odkbase_basic_values.h"
 #include "odkbase_api_object_ptr.h"
+#include "odkfw_data_region_cache.h"
 #include "odkfw_stream_reader.h"
 
 #include "odkapi_data_set_descriptor_xml.h"
 #include "odkfw_stream_iterator.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,11 +45,65 @@ namespace framework
         static uint64_t m_next_id;
     };
 
+    /**
+     * Sizes DATA_READ windows (in seconds) so that each request returns about
+     * a byte budget and completes within a latency budget.
+     * Every answered request is measured and the next window grows or shrinks
+     * towards the budgets, by at most a factor of two per step.
+     */
+    class DataWindowSizer
+    {
+    public:
+        static constexpr std::uint64_t DEFAULT_TARGET_BYTES = 4 * 1024 * 1024;
+        static constexpr double DEFAULT_TARGET_LATENCY = 0.05;
+        static constexpr double MAX_STEP = 2.0;
+
+        explicit DataWindowSizer(double initial_interval,
+            std::uint64_t target_bytes = DEFAULT_TARGET_BYTES,
+            double target_latency = DEFAULT_TARGET_LATENCY);
+
+        /**
+         * Limits the window length, the current interval is clamped into the new bounds.
+         */
+        void setLimits(double min_interval, double max_interval);
+
+        /**
+         * Estimates the initial window from the expected data rate
+         */
+        void setExpectedRate(double bytes_per_second);
+
+        /**
+         * Adapts the window to a request covering interval seconds that returned received_bytes after latency seconds
+         */
+        void update(double interval, std::uint64_t received_bytes, double latency);
+
+        ODK_NODISCARD double getInterval() const noexcept;
+
+    private:
+        double clamp(double interval) const noexcept;
+
+        double m_interval;
+        double m_min_interval;
+        double m_max_interval;
+        std::uint64_t m_target_bytes;
+        double m_target_latency;
+    };
+
+    /**
+     * Returns the valid data regions of the DATA_READ answer for the window [start, end]
+     * regions sent along with the block list (PluginDataRequest::m_include_data_regions) are used directly,
+     * hosts not supporting this are asked with an additional DATA_REGIONS_READ
+     */
+    std::vector<DataRegion> getBlockListDataRegions(odk::IfHost* host, std::uint64_t data_set_id,
+        const BlockListDescriptor& block_list_descriptor, double start, double end);
+
+    std::vector<DataRegion> getBlockListDataRegions(odk::IfHost* host, std::uint64_t data_set_id,
+        const odk::IfDataBlockList* block_list, double start, double end);
+
     class DataRequester : public IfIteratorUpdater
     {
         static constexpr uint64_t BLOCK_SIZE = 1000;
         static constexpr double DEFAULT_REQUEST_INTERVAL = 0.1;
-        static constexpr uint64_t SAMPLES_PER_REQUEST = 100000;
 
     public:
         DataRequester(odk::IfHost *host, std::shared_ptr<InputChannel> channel, bool user_reduced = false);
@@ -53,27 +114,207 @@ namespace framework
 
         void setupDataRequest();
 
+        /**
+         * Enables read-ahead: while the current window is consumed, the next one
+         * is requested from the host on a background thread.
+         * At most one window is prefetched, so memory stays bounded to the
+         * previous, the current and the prefetched block list.
+         */
+        void setPrefetchEnabled(bool enabled);
+
+        ODK_NODISCARD bool isPrefetchEnabled() const noexcept;
+
         void fetchMoreData();
 
         void updateStreamIterator(StreamIterator* iterator) final;
 
         std::shared_ptr<StreamIterator> getIterator(double start, double end);
 
+        /**
+         * Restarts reading at position without requesting data, the next updateStreamIterator call reads the first window
+         * unlike getIterator, reduced data does not start one reduced sample before position
+         */
+        void resetPosition(double position, double end);
+
         std::vector<DataRegion> getDataRegions(double start, double end);
 
     private:
+        struct DataWindow
+        {
+            odk::detail::ApiObjectPtr<const IfDataBlockList> m_data_block_list;
+            std::vector<DataRegion> m_data_regions;
+            double m_end_position = 0.0;
+            bool m_complete = true;
+            /// Measurement of the last DATA_READ: requested seconds, returned bytes and round trip time
+            double m_read_interval = 0.0;
+            std::uint64_t m_read_bytes = 0;
+            double m_read_latency = 0.0;
+        };
+
+        /**
+         * Requests data windows of interval seconds starting at position until a non-empty block list is returned.
+         * Only reads state that stays constant while a request is in flight, so it can run
+         * on the prefetch thread.
+         */
+        DataWindow readWindow(double position, double interval) const;
+        std::vector<DataRegion> readDataRegions(double start, double end) const;
+
+        /**
+         * Fetches the data regions of the whole interval [start, end] with a single request
+         */
+        void updateRegionCache(double start, double end);
+        void startPrefetch();
+        void cancelPrefetch();
+
         odk::IfHost* m_host;
         double m_current_position;
         double m_end_position;
         std::shared_ptr<InputChannel> m_channel;
         DataSetDescriptor m_dataset_descriptor;
         odk::detail::ApiObjectPtr<const IfDataBlockList> m_data_block_list;
+        /// Previous window is kept alive so chunks handed out by StreamIterator::nextChunk stay valid
+        odk::detail::ApiObjectPtr<const IfDataBlockList> m_previous_data_block_list;
         odk::framework::StreamReader m_stream_reader;
         std::shared_ptr<StreamIterator> m_iterator;
         bool m_is_single_value;
         bool m_user_reduced;
-        double m_data_request_interval;
+        DataWindowSizer m_window_sizer;
         std::uint64_t m_ratio;
+        bool m_prefetch_enabled;
+        std::future<DataWindow> m_prefetch;
+        /// Data regions of the interval of the last getIterator call, only modified while no prefetch is running
+        DataRegionCache m_region_cache;
+    };
+
+    /**
+     * Requests the data of several channels with a single data set.
+     * Every DATA_READ returns the blocks of all channels and the per-channel iterators share
+     * the returned block lists, so exports advancing all channels together read each window once.
+     * A window is released when every iterator has moved past it, at most MAX_BUFFERED_WINDOWS
+     * are kept beyond that. An iterator reaching a window that has already been dropped continues
+     * with a DataRequester of its own instead of reading the data of all channels again.
+     * Single value channels are not supported, use DataRequester for them.
+     */
+    class MultiChannelDataRequester
+    {
+        static constexpr uint64_t BLOCK_SIZE = 1000;
+        static constexpr double DEFAULT_REQUEST_INTERVAL = 0.1;
+        static constexpr std::size_t MAX_BUFFERED_WINDOWS = 4;
+
+    public:
+        MultiChannelDataRequester(odk::IfHost* host, const std::vector<std::shared_ptr<InputChannel>>& channels, bool user_reduced = false);
+
+        MultiChannelDataRequester(const MultiChannelDataRequester&) = delete;
+
+        ~MultiChannelDataRequester();
+
+        /**
+         * Enables read-ahead of the next window, see DataRequester::setPrefetchEnabled
+         */
+        void setPrefetchEnabled(bool enabled);
+
+        ODK_NODISCARD bool isPrefetchEnabled() const noexcept;
+
+        /**
+         * Returns iterators over [start, end] for all channels contained in the data set.
+         * The iterators stay owned by the requester and are repositioned by subsequent calls.
+         * Channels failing to read their first data are left out, the other channels are still returned.
+         */
+        std::map<std::uint64_t, std::shared_ptr<StreamIterator>> getIterators(double start, double end);
+
+        /**
+         * Returns the valid data regions of all channels
+         */
+        std::vector<DataRegion> getDataRegions(double start, double end) const;
+
+        /**
+         * Returns the number of DATA_READ requests sent to the host for the shared data set
+         */
+        ODK_NODISCARD std::uint64_t getReadCount() const noexcept;
+
+    private:
+        static constexpr std::size_t NO_WINDOW = std::numeric_limits<std::size_t>::max();
+
+        class ChannelUpdater : public IfIteratorUpdater
+        {
+        public:
+            ChannelUpdater(MultiChannelDataRequester& requester, std::shared_ptr<InputChannel> channel);
+
+            void updateStreamIterator(StreamIterator* iterator) final;
+
+            std::vector<DataRegion> getDataRegions(double start, double end) final;
+
+            MultiChannelDataRequester& m_requester;
+            std::shared_ptr<InputChannel> m_channel;
+            std::uint64_t m_ratio;
+            /// Stream of the channel in the data set descriptor, nullptr if the host did not add the channel
+            const StreamDescriptor* m_stream;
+            std::shared_ptr<StreamIterator> m_iterator;
+            /// Windows supplying the current and the previous ranges, both are kept alive for handed out chunks
+            std::size_t m_current_window;
+            std::size_t m_previous_window;
+            std::size_t m_next_window;
+            /// Own requester of an iterator that fell behind the buffered windows, nullptr while it reads the shared windows
+            std::unique_ptr<DataRequester> m_fallback;
+        };
+
+        struct Window
+        {
+            odk::detail::ApiObjectPtr<const IfDataBlockList> m_data_block_list;
+            StreamReader m_stream_reader;
+            const StreamDescriptor* m_stream;
+        };
+
+        struct WindowData
+        {
+            odk::detail::ApiObjectPtr<const IfDataBlockList> m_data_block_list;
+            std::vector<DataRegion> m_data_regions;
+            double m_end_position = 0.0;
+            bool m_complete = true;
+            double m_read_interval = 0.0;
+            std::uint64_t m_read_bytes = 0;
+            double m_read_latency = 0.0;
+        };
+
+        void setupDataRequest();
+        void updateChannelIterator(ChannelUpdater& channel, StreamIterator& iterator);
+
+        ODK_NODISCARD bool hasWindow(std::size_t index) const noexcept;
+        ODK_NODISCARD bool isDropped(std::size_t index) const noexcept;
+        Window* getWindow(std::size_t index);
+        void startFallback(ChannelUpdater& channel, double position);
+        void releaseWindows();
+        void clearWindows();
+
+        /**
+         * Requests data from position on, the window is moved forward until a non-empty block list is returned.
+         * Like DataRequester::readWindow this may run on the prefetch thread.
+         */
+        WindowData readWindow(double position, double interval) const;
+        std::vector<DataRegion> readDataRegions(double start, double end) const;
+
+        /**
+         * Fetches the data regions of all channels for the whole interval [start, end] with a single request
+         */
+        void updateRegionCache(double start, double end);
+        void startPrefetch();
+        void cancelPrefetch();
+
+        odk::IfHost* m_host;
+        bool m_user_reduced;
+        double m_end_position;
+        DataSetDescriptor m_dataset_descriptor;
+        std::map<std::uint64_t, std::unique_ptr<ChannelUpdater>> m_channels;
+        /// Start positions of all windows read so far, followed by the end of the last one
+        std::vector<double> m_window_bounds;
+        std::map<std::size_t, std::unique_ptr<Window>> m_windows;
+        std::vector<std::unique_ptr<Window>> m_spare_windows;
+        DataWindowSizer m_window_sizer;
+        bool m_prefetch_enabled;
+        std::future<WindowData> m_prefetch;
+        mutable std::atomic<std::uint64_t> m_read_count;
+        /// Data regions of the interval of the last getIterators call, only modified while no prefetch is running
+        DataRegionCache m_region_cache;
     };
 }
 }
@@ -18,6 +18,7 @@ namespace odk
 namespace framework
 {
     class DataRequester;
+    class MultiChannelDataRequester;
 
     class ExportInstance
     {
@@ -65,12 +66,32 @@ namespace framework
 
         void notifyProgress(uint64_t progress, const std::string& extra_info = {}) const;
 
+        /**
+         * Requests all channels except single value channels with one shared data set (@see MultiChannelDataRequester)
+         * only pays off for exports advancing all channel iterators together, has to be called before the export is started
+         */
+        void setSharedDataSetEnabled(bool enabled) noexcept;
+
     private:
+        /**
+         * Requests the channel with a DataRequester of its own
+         */
+        void addChannelRequester(uint64_t channel_id, const std::shared_ptr<InputChannel>& channel, bool user_reduced, double start, double end);
+
+        /**
+         * Requests the channels with one MultiChannelDataRequester, channels it cannot provide get a DataRequester of their own
+         */
+        void addSharedRequester(const std::vector<std::shared_ptr<InputChannel>>& channels, bool user_reduced, double start, double end);
+
         odk::IfHost* m_host = nullptr;
         std::thread m_worker_thread;
         std::atomic<bool> m_canceled = false;
+        bool m_shared_data_set = false;
         std::vector<std::unique_ptr<DataRequester>> m_data_requester;
         std::vector<std::unique_ptr<DataRequester>> m_reduced_requester;
+        /// Shared data sets for all channels that are not single value channels
+        std::unique_ptr<MultiChannelDataRequester> m_multi_channel_requester;
+        std::unique_ptr<MultiChannelDataRequester> m_reduced_multi_channel_requester;
         ProcessingContext m_context;
         odk::StartExport m_telegram;
     };
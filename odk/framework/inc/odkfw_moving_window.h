@@ -0,0 +1,249 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+
+#include "odkuni_defines.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Sum and average over the last N samples of a stream with O(1) cost per sample
+     *
+     * The samples of the window are kept in a ring buffer, every new sample is added to a running sum
+     * and the sample leaving the window is subtracted. The running sum is compensated (Kahan-Babuska),
+     * so rounding errors do not accumulate over long acquisitions.
+     *
+     * Non-finite samples (NaN for gaps of the input channel, but also infinities) are not added to the sum
+     * but counted, the sum and average are NaN while the window contains at least one of them and valid
+     * again once they left it. An infinity in the running sum would turn it into NaN (inf - inf) for good.
+     */
+    template <class T>
+    class MovingWindow
+    {
+        static_assert(std::is_floating_point_v<T>, "The compensated running sum requires a floating point type");
+
+    public:
+        explicit MovingWindow(std::size_t window_size = 1)
+            : m_values(std::max<std::size_t>(window_size, 1))
+        {
+        }
+
+        /**
+         * Change the number of samples in the window, this also resets the window
+         */
+        void setWindowSize(std::size_t window_size)
+        {
+            m_values.assign(std::max<std::size_t>(window_size, 1), T(0));
+            reset();
+        }
+
+        ODK_NODISCARD std::size_t getWindowSize() const noexcept
+        {
+            return m_values.size();
+        }
+
+        /**
+         * Remove all samples from the window
+         */
+        void reset() noexcept
+        {
+            m_position = 0;
+            m_count = 0;
+            m_non_finite_count = 0;
+            m_sum = 0;
+            m_compensation = 0;
+        }
+
+        /**
+         * Number of samples in the window, less than the window size until it was filled once
+         */
+        ODK_NODISCARD std::size_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        ODK_NODISCARD bool isFull() const noexcept
+        {
+            return m_count == m_values.size();
+        }
+
+        /**
+         * Number of NaN and infinite samples in the window
+         */
+        ODK_NODISCARD std::size_t getNonFiniteCount() const noexcept
+        {
+            return m_non_finite_count;
+        }
+
+        /**
+         * Sum of the samples in the window, NaN if the window contains non-finite samples
+         */
+        ODK_NODISCARD T getSum() const noexcept
+        {
+            return m_non_finite_count == 0 ? m_sum + m_compensation : std::numeric_limits<T>::quiet_NaN();
+        }
+
+        /**
+         * Average of the samples in the window, NaN if the window is empty or contains non-finite samples
+         */
+        ODK_NODISCARD T getAverage() const noexcept
+        {
+            return m_count > 0 ? getSum() / static_cast<T>(m_count) : std::numeric_limits<T>::quiet_NaN();
+        }
+
+        /**
+         * Add a sample, the oldest sample leaves the window if it is full
+         */
+        void push(T value) noexcept
+        {
+            if (isFull())
+            {
+                remove(m_values[m_position]);
+            }
+            else
+            {
+                ++m_count;
+            }
+
+            m_values[m_position] = value;
+            if (!std::isfinite(value))
+            {
+                ++m_non_finite_count;
+            }
+            else
+            {
+                add(m_sum, m_compensation, value);
+            }
+
+            if (++m_position == m_values.size())
+            {
+                m_position = 0;
+            }
+        }
+
+        /**
+         * Add count samples and write the average for every sample that leaves a full window behind
+         *
+         * Once the window is full, the samples are processed in spans that are contiguous in the ring buffer.
+         * Spans without non-finite samples in the input and the window run a loop without wrap-around or finiteness checks.
+         *
+         * @param output receives up to count averages, output[0] belongs to the first input sample completing the window
+         * @return number of averages written
+         */
+        std::size_t addSamples(const T* input, std::size_t count, T* output) noexcept
+        {
+            std::size_t n = 0;
+            std::size_t written = 0;
+            for (; n < count && !isFull(); ++n)
+            {
+                push(input[n]);
+                if (isFull())
+                {
+                    output[written++] = getAverage();
+                }
+            }
+
+            const std::size_t window_size = m_values.size();
+            const T scale = T(1) / static_cast<T>(window_size);
+            while (n < count)
+            {
+                const std::size_t span = std::min(count - n, window_size - m_position);
+                const T* new_values = input + n;
+                T* old_values = m_values.data() + m_position;
+                T* averages = output + written;
+
+                // the full window holds no non-finite samples if none are counted
+                if (m_non_finite_count == 0 && countNonFinite(new_values, span) == 0)
+                {
+                    T sum = m_sum;
+                    T compensation = m_compensation;
+                    for (std::size_t i = 0; i < span; ++i)
+                    {
+                        add(sum, compensation, new_values[i]);
+                        add(sum, compensation, -old_values[i]);
+                        averages[i] = sum + compensation;
+                    }
+                    m_sum = sum;
+                    m_compensation = compensation;
+
+                    for (std::size_t i = 0; i < span; ++i)
+                    {
+                        averages[i] *= scale;
+                    }
+                    std::copy(new_values, new_values + span, old_values);
+                    m_position = m_position + span == window_size ? 0 : m_position + span;
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < span; ++i)
+                    {
+                        push(new_values[i]);
+                        averages[i] = getAverage();
+                    }
+                }
+
+                n += span;
+                written += span;
+            }
+            return written;
+        }
+
+    private:
+        /**
+         * Kahan-Babuska summation: the rounding error of every addition is collected in compensation
+         */
+        static void add(T& sum, T& compensation, T value) noexcept
+        {
+            const T t = sum + value;
+            compensation += std::abs(sum) >= std::abs(value) ? (sum - t) + value : (value - t) + sum;
+            sum = t;
+        }
+
+        void remove(T value) noexcept
+        {
+            if (!std::isfinite(value))
+            {
+                // the compensated sum only contains finite samples, restart it exactly when there are none left
+                --m_non_finite_count;
+                if (m_non_finite_count + 1 == m_count)
+                {
+                    m_sum = 0;
+                    m_compensation = 0;
+                }
+            }
+            else
+            {
+                add(m_sum, m_compensation, -value);
+            }
+        }
+
+        /**
+         * Branch-free count of non-finite values, v - v is 0 for finite values and NaN for NaN and infinities
+         */
+        static std::size_t countNonFinite(const T* values, std::size_t count) noexcept
+        {
+            std::size_t non_finite_count = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                non_finite_count += values[i] - values[i] != T(0) ? 1 : 0;
+            }
+            return non_finite_count;
+        }
+
+        std::vector<T> m_values;        ///< ring buffer of the window samples
+        std::size_t m_position = 0;     ///< index of the next sample in m_values, the oldest one once the window is full
+        std::size_t m_count = 0;
+        std::size_t m_non_finite_count = 0;
+        T m_sum = 0;
+        T m_compensation = 0;
+    };
+}
+}
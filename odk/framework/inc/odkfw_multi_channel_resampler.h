@@ -0,0 +1,89 @@
+// Copyright DEWETRON GmbH 2026
+
+#pragma once
+
+#include "odkfw_contiguous_sample_buffer.h"
+#include "odkfw_resampler.h"
+#include "odkbase_if_host_fwd.h"
+#include "odkuni_defines.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace odk
+{
+    namespace framework
+    {
+        /**
+         * Resampler for sources delivering several channels sampled with one shared clock
+         *
+         * Works like Resampler, but the timing is estimated once for all channels and the interpolation
+         * positions and weights of a block are computed once, then applied to every channel.
+         */
+        class MultiChannelResampler
+        {
+        public:
+            /**
+             * Order of the samples passed to addSamples
+             */
+            enum class Layout
+            {
+                INTERLEAVED,    ///< sample 0 of all channels, then sample 1 of all channels, ...
+                PLANAR,         ///< all samples of channel 0, then all samples of channel 1, ...
+            };
+
+            /**
+             * Create a resampler for channel_count channels and set the desired output rate (nominal sample rate)
+             */
+            explicit MultiChannelResampler(std::size_t channel_count = 1, double nominal_sample_rate = 1, Layout layout = Layout::INTERLEAVED);
+
+            void setNominalSampleRate(double rate);
+            ODK_NODISCARD double getNominalSampleRate() const { return m_nominal_sample_rate; }
+
+            ODK_NODISCARD std::size_t getChannelCount() const { return m_last_samples.size(); }
+            ODK_NODISCARD Layout getLayout() const { return m_layout; }
+
+            /**
+             * Return the timestamp of the last call to addSamples
+             */
+            ODK_NODISCARD double getLastTimestamp() const { return m_timebase.getLastTimestamp(); }
+            /**
+             * Return the number of samples already sent to each output channel
+             */
+            ODK_NODISCARD std::size_t getSampleCount() const { return m_actual_scnt; }
+
+            /**
+             * Return the timing estimate of the input, e.g. to enable drift tracking or to read the estimated sample rate
+             */
+            ODK_NODISCARD ResamplerTimebase& getTimebase() { return m_timebase; }
+            ODK_NODISCARD const ResamplerTimebase& getTimebase() const { return m_timebase; }
+
+            /**
+             * Reset all channel related data
+             */
+            void reset();
+
+            /**
+             * Resample num_samples samples of every channel and send them to the output channels
+             * Every channel is sent with one odk::host_msg::ADD_CONTIGUOUS_SAMPLES message, all using the same timestamp
+             *
+             * @param local_channel_ids output channel of each input channel, getChannelCount() entries
+             * @param last_sample_timestamp exact time in seconds since acquisition start of the last sample
+             * @param data num_samples * getChannelCount() values ordered as specified by the layout
+             * @param num_samples number of samples per channel in data
+             * @return first error returned by host->messageSyncData
+             */
+            std::uint64_t addSamples(odk::IfHost* host, const std::uint32_t* local_channel_ids, double last_sample_timestamp, const double* data, std::size_t num_samples);
+
+        private:
+            double m_nominal_sample_rate;
+            Layout m_layout;
+            ResamplerTimebase m_timebase;
+            std::size_t m_actual_scnt;
+            std::vector<double> m_last_samples;             ///< last input sample of every channel, interpolation history for the next call
+            std::vector<std::size_t> m_indices;             ///< input index of each output sample, shared by all channels
+            std::vector<double> m_weights;                  ///< interpolation weight of the following input sample
+            ContiguousSampleBuffer<double> m_output_buffer;
+        };
+    }
+}
@@ -0,0 +1,59 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+
+#include "odkbase_if_host.h"
+#include "odkfw_thread_pool.h"
+#include "odkuni_defines.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Runs jobs that communicate with the host concurrently on a WorkStealingThreadPool
+     *
+     * Every job receives a proxy instead of the real host. The thread calling run() waits for
+     * all jobs and executes their host calls in the meantime, so the host is only ever called
+     * from that thread. ADD_SAMPLE and ADD_CONTIGUOUS_SAMPLES messages without return value are
+     * copied and queued without blocking the job, all other calls wait for the host's answer.
+     */
+    class ParallelTaskExecutor
+    {
+    public:
+        using Job = std::function<void(odk::IfHost* host)>;
+
+        /**
+         * @param thread_count  number of worker threads, 0 uses one per hardware thread
+         */
+        explicit ParallelTaskExecutor(std::size_t thread_count = 0);
+        ~ParallelTaskExecutor();
+
+        ODK_NODISCARD std::size_t getThreadCount() const noexcept;
+
+        /**
+         * Pool running the jobs, can be used for additional work inside of a job (@see WorkStealingThreadPool::parallelFor)
+         */
+        ODK_NODISCARD WorkStealingThreadPool& getThreadPool() noexcept;
+
+        /**
+         * Runs all jobs and returns when all of them are finished
+         * a single job is run directly on the calling thread with the real host
+         * the first exception thrown by a job is rethrown after all jobs finished
+         * a host call that throws rethrows on the job's thread, a queued sample message on the thread calling run()
+         * the host passed to a job is only valid until the job returns and must not be stored
+         */
+        void run(odk::IfHost* host, const std::vector<Job>& jobs);
+
+    private:
+        class CallQueue;
+        class HostProxy;
+
+        WorkStealingThreadPool m_pool;
+    };
+}
+}
@@ -0,0 +1,88 @@
+// Copyright DEWETRON GmbH 2026
+
+#pragma once
+
+#include "odkfw_resampler.h"
+#include "odkbase_if_host_fwd.h"
+#include "odkuni_defines.h"
+#include <cstdint>
+#include <vector>
+
+namespace odk
+{
+    namespace framework
+    {
+        /**
+         * Resampler using a windowed-sinc interpolation filter instead of linear interpolation
+         *
+         * The input timing is estimated the same way as in Resampler.
+         * Each output sample is computed from tap_count input samples around its position, using the
+         * precomputed coefficients of the nearest of phase_count fractional positions (polyphase filter bank).
+         * Input samples are kept between calls as filter history, so the output of an addSamples call
+         * ends tap_count / 2 input samples before the latest input sample; it is sent with the next call.
+         */
+        class PolyphaseResampler
+        {
+        public:
+            /**
+             * Create a resampler and set the desired output rate (nominal sample rate)
+             *
+             * @param tap_count number of input samples per output sample, rounded up to a multiple of 4
+             * @param phase_count number of precomputed fractional positions between two input samples
+             * @param cutoff cutoff frequency of the interpolation filter relative to the input sample rate,
+             *               has to be lowered below 0.5 * output rate / input rate when downsampling
+             */
+            PolyphaseResampler(double nominal_sample_rate = 1, std::size_t tap_count = 32, std::size_t phase_count = 128, double cutoff = 0.45);
+
+            void setNominalSampleRate(double rate);
+            ODK_NODISCARD double getNominalSampleRate() const { return m_nominal_sample_rate; }
+
+            ODK_NODISCARD std::size_t getTapCount() const { return m_tap_count; }
+            ODK_NODISCARD std::size_t getPhaseCount() const { return m_phase_count; }
+
+            /**
+             * Return the timestamp of the last call to addSamples
+             */
+            ODK_NODISCARD double getLastTimestamp() const { return m_timebase.getLastTimestamp(); }
+            /**
+             * Return the number of samples already sent to the output channel
+             */
+            ODK_NODISCARD std::size_t getSampleCount() const { return m_actual_scnt; }
+
+            /**
+             * Return the timing estimate of the input, e.g. to enable drift tracking or to read the estimated sample rate
+             */
+            ODK_NODISCARD ResamplerTimebase& getTimebase() { return m_timebase; }
+            ODK_NODISCARD const ResamplerTimebase& getTimebase() const { return m_timebase; }
+
+            /**
+             * Reset all channel related data
+             */
+            void reset();
+
+            /**
+             * Add samples to the output channel <local_channel_id> but resample all <data> samples to match the nominal sample rate
+             * After resampling, the data is sent to the host with odk::host_msg::ADD_CONTIGUOUS_SAMPLES using a computed timestamp in the nominal rate
+             *
+             * @param last_sample_timestamp exact time in seconds since acquisition start of the last sample (data[num_samples-1])
+             * @param data pointer to the first sample
+             * @param num_samples number of samples in data
+             * @return result of host->messageSyncData
+             */
+            std::uint64_t addSamples(odk::IfHost* host, std::uint32_t local_channel_id, double last_sample_timestamp, const double* data, std::size_t num_samples);
+
+        private:
+            void computeCoefficients(double cutoff);
+
+            double m_nominal_sample_rate;
+            std::size_t m_tap_count;
+            std::size_t m_phase_count;
+            std::vector<double> m_coefficients;     ///< phase_count + 1 rows of tap_count coefficients
+            ResamplerTimebase m_timebase;
+            std::size_t m_actual_scnt;
+            std::vector<double> m_history;          ///< input samples starting at input position m_history_start
+            std::int64_t m_history_start;
+            std::vector<double> m_output_buffer;
+        };
+    }
+}
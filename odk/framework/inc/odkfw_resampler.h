@@ -4,12 +4,120 @@
 
 #include "odkbase_if_host_fwd.h"
 #include "odkuni_defines.h"
+#include <cstdint>
 #include <vector>
 
 namespace odk
 {
     namespace framework
     {
+        /**
+         * Estimates the timing of resampler input from the timestamps of the added sample blocks
+         *
+         * The samples of a block are assumed to be evenly spaced, the block ending at its timestamp.
+         * Samples of earlier blocks are placed backwards from the latest timestamp using the latest sample duration.
+         *
+         * By default the sample duration is taken from the latest block only, so timestamp jitter directly modulates
+         * the resampling ratio. With drift tracking enabled, an alpha-beta filter (a second order tracking loop)
+         * follows the clock instead: the end of every block is predicted from the model, and only a fraction of the
+         * prediction error corrects the model timestamp and sample rate. Jitter is averaged over many blocks
+         * while a constant drift of the source clock is tracked without remaining error.
+         * The samples of a block are then spaced between the previous and the new model timestamp, so the input positions
+         * stay continuous and the phase correction is spread over the block.
+         */
+        class ResamplerTimebase
+        {
+        public:
+            /**
+             * Input positions of the output samples of linear interpolation, relative to the first sample of the latest block
+             */
+            struct OutputPositions
+            {
+                double m_first = 0;         ///< position of the first output sample, -1 is the last sample of the previous block
+                double m_step = 0;          ///< position increment per output sample
+                std::size_t m_count = 0;    ///< number of output samples positioned before the last input sample
+            };
+
+            ResamplerTimebase();
+
+            /**
+             * Reset the estimate, the drift tracking setting is kept
+             */
+            void reset();
+
+            /**
+             * Enable tracking of the source clock with the given loop gain
+             * Smaller gains average over more blocks, roughly 2 / gain blocks, but need longer to settle.
+             * A gain of 1 (or more) disables tracking, every block then determines the sample duration on its own.
+             * @param gain phase correction per block in (0, 1], the frequency correction is derived from it
+             */
+            void setDriftTracking(double gain);
+            ODK_NODISCARD double getDriftTracking() const { return m_tracking_gain; }
+            ODK_NODISCARD bool isDriftTrackingEnabled() const { return m_tracking_gain < 1.0; }
+
+            /**
+             * Updates the estimate with a block of num_samples input samples
+             * @param last_sample_timestamp exact time in seconds since acquisition start of the last sample of the block
+             */
+            void addBlock(double last_sample_timestamp, std::size_t num_samples);
+
+            /**
+             * Return the timestamp of the last added block
+             */
+            ODK_NODISCARD double getLastTimestamp() const { return m_last_timestamp; }
+
+            /**
+             * Return the duration of one input sample of the latest block in seconds, 0 before the first block
+             */
+            ODK_NODISCARD double getSampleDuration() const { return m_sample_duration; }
+
+            /**
+             * Return the number of input samples added since the last reset
+             */
+            ODK_NODISCARD std::uint64_t getSampleCount() const { return m_sample_count; }
+
+            /**
+             * Return the estimated input sample rate, 0 before the first block
+             */
+            ODK_NODISCARD double getEstimatedSampleRate() const { return m_tracked_sample_duration > 0.0 ? 1.0 / m_tracked_sample_duration : 0.0; }
+
+            /**
+             * Return the relative deviation of the estimated input sample rate from nominal_rate, e.g. 1e-6 for 1ppm fast
+             */
+            ODK_NODISCARD double getDrift(double nominal_rate) const { return getEstimatedSampleRate() / nominal_rate - 1.0; }
+
+            /**
+             * Return the difference of the latest block timestamp to the timestamp predicted by the model in seconds
+             * Always 0 without drift tracking, with tracking it shows the timestamp jitter and how well the loop is locked.
+             */
+            ODK_NODISCARD double getTimestampError() const { return m_timestamp_error; }
+
+            /**
+             * Return the estimated position of time in the input stream, input sample n being at position n
+             */
+            ODK_NODISCARD double getPosition(double time) const
+            {
+                return static_cast<double>(m_sample_count) + (time - m_model_timestamp) / m_sample_duration;
+            }
+
+            /**
+             * Return the positions of the output samples starting at first_tick that can be interpolated from the latest block
+             * and the last sample of the previous block, positions before that sample are clamped to it
+             */
+            ODK_NODISCARD OutputPositions getOutputPositions(std::uint64_t first_tick, double output_rate) const;
+
+        private:
+            double m_last_timestamp;
+            double m_model_timestamp;           ///< estimated time of the last sample, equals m_last_timestamp without drift tracking
+            double m_sample_duration;           ///< spacing of the samples of the latest block
+            double m_tracked_sample_duration;   ///< sample duration estimated by the tracking loop
+            double m_timestamp_error;
+            double m_tracking_gain;
+            std::uint64_t m_sample_count;
+            std::size_t m_block_size;
+            std::size_t m_block_count;
+        };
+
         /**
          * The Resampler allows to use samples from a source with an unstable sampling frequency but precise timestamps
          * It allows to add samples to an output channel while estimating the underlying real sample rate
@@ -29,12 +137,18 @@ namespace odk
             /**
              * Return the timestamp of the last call to addSamples
              */
-            ODK_NODISCARD double getLastTimestamp() const { return m_last_timestamp; }
+            ODK_NODISCARD double getLastTimestamp() const { return m_timebase.getLastTimestamp(); }
             /**
              * Return the number of samples already sent to the output channel
              */
             ODK_NODISCARD std::size_t getSampleCount() const { return m_actual_scnt; }
 
+            /**
+             * Return the timing estimate of the input, e.g. to enable drift tracking or to read the estimated sample rate
+             */
+            ODK_NODISCARD ResamplerTimebase& getTimebase() { return m_timebase; }
+            ODK_NODISCARD const ResamplerTimebase& getTimebase() const { return m_timebase; }
+
             /**
              * Reset all channel related data
              */
@@ -53,9 +167,9 @@ namespace odk
 
         protected:
             double m_nomianal_sample_rate;
-            double m_last_timestamp;
+            ResamplerTimebase m_timebase;
             std::size_t m_actual_scnt;
-            std::vector<double> m_input_buffer;
+            double m_last_sample;   ///< last input sample, interpolation history for the next call
             std::vector<double> m_output_buffer;
         };
     }
@@ -0,0 +1,245 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+#define ODK_EXTENSION_FUNCTIONS //enable C++ integration
+
+#include "odkbase_if_host.h"
+#include "odkfw_contiguous_sample_buffer.h"
+#include "odkuni_defines.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Lock-free ring buffer for exactly one producer thread and one consumer thread
+     *
+     * The capacity is rounded up to a power of two. Read and write positions are only written
+     * by their own side and live on separate cache lines, each side additionally caches the
+     * position of the other side, so the shared positions are only loaded when the cached one
+     * does not suffice.
+     */
+    template <class T>
+    class SampleRingBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Samples are copied as raw values");
+
+    public:
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        explicit SampleRingBuffer(std::size_t capacity)
+            : m_capacity(roundUpCapacity(capacity))
+            , m_mask(m_capacity - 1)
+            , m_data(std::make_unique<T[]>(m_capacity))
+        {
+        }
+
+        SampleRingBuffer(const SampleRingBuffer&) = delete;
+        SampleRingBuffer& operator=(const SampleRingBuffer&) = delete;
+
+        ODK_NODISCARD std::size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        /**
+         * Number of stored samples, exact only when called by producer or consumer while the other side is idle
+         */
+        ODK_NODISCARD std::size_t size() const noexcept
+        {
+            return m_write.m_position.load(std::memory_order_acquire) - m_read.m_position.load(std::memory_order_acquire);
+        }
+
+        ODK_NODISCARD bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /**
+         * Producer: appends up to count samples, returns the number of samples written
+         */
+        std::size_t push(const T* samples, std::size_t count) noexcept
+        {
+            const auto write = m_write.m_position.load(std::memory_order_relaxed);
+            if (m_capacity - (write - m_write.m_other_position) < count)
+            {
+                m_write.m_other_position = m_read.m_position.load(std::memory_order_acquire);
+            }
+
+            count = std::min(count, m_capacity - (write - m_write.m_other_position));
+            const auto offset = write & m_mask;
+            const auto first = std::min(count, m_capacity - offset);
+            std::copy(samples, samples + first, m_data.get() + offset);
+            std::copy(samples + first, samples + count, m_data.get());
+
+            m_write.m_position.store(write + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Producer: appends a single sample, returns false if the buffer is full
+         */
+        bool push(const T& sample) noexcept
+        {
+            return push(&sample, 1) == 1;
+        }
+
+        /**
+         * Consumer: calls fn(const T* samples, std::size_t count) for the stored samples in order,
+         * at most max_count samples in up to two contiguous spans, and releases them afterwards
+         *
+         * @return number of consumed samples
+         */
+        template <class Function>
+        std::size_t consume(Function&& fn, std::size_t max_count = std::numeric_limits<std::size_t>::max())
+        {
+            const auto read = m_read.m_position.load(std::memory_order_relaxed);
+            if (m_read.m_other_position - read < max_count)
+            {
+                m_read.m_other_position = m_write.m_position.load(std::memory_order_acquire);
+            }
+
+            const auto count = std::min(max_count, m_read.m_other_position - read);
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            const auto offset = read & m_mask;
+            const auto first = std::min(count, m_capacity - offset);
+            fn(static_cast<const T*>(m_data.get() + offset), first);
+            if (first < count)
+            {
+                fn(static_cast<const T*>(m_data.get()), count - first);
+            }
+
+            m_read.m_position.store(read + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Consumer: copies up to max_count samples to samples, returns the number of samples read
+         */
+        std::size_t pop(T* samples, std::size_t max_count)
+        {
+            return consume([&samples](const T* data, std::size_t count)
+                {
+                    samples = std::copy(data, data + count, samples);
+                }, max_count);
+        }
+
+    private:
+        static std::size_t roundUpCapacity(std::size_t capacity) noexcept
+        {
+            std::size_t rounded = 1;
+            while (rounded < capacity)
+            {
+                rounded <<= 1;
+            }
+            return rounded;
+        }
+
+        /// position owned by one side and its cached copy of the position of the other side
+        struct alignas(CACHE_LINE_SIZE) Position
+        {
+            std::atomic<std::size_t> m_position{0};
+            std::size_t m_other_position = 0;
+        };
+
+        const std::size_t m_capacity;
+        const std::size_t m_mask;
+        std::unique_ptr<T[]> m_data;
+        Position m_write;
+        Position m_read;
+    };
+
+    /**
+     * Decouples the generation of synchronous samples from the process call of a source channel
+     *
+     * A producer thread pushes samples whenever they are ready, process() calls send() to forward
+     * everything available with a single odk::host_msg::ADD_CONTIGUOUS_SAMPLES message.
+     * Timestamps are continuous ticks starting at the tick passed to reset().
+     */
+    template <class T>
+    class SyncSourceBuffer
+    {
+    public:
+        explicit SyncSourceBuffer(std::size_t capacity)
+            : m_ring_buffer(capacity)
+            , m_next_tick(0)
+        {
+            m_output_buffer.reserve(m_ring_buffer.capacity());
+        }
+
+        /**
+         * Producer: appends up to count samples, returns the number of samples written
+         */
+        std::size_t push(const T* samples, std::size_t count) noexcept
+        {
+            return m_ring_buffer.push(samples, count);
+        }
+
+        /**
+         * Number of samples that can be pushed without loss
+         */
+        ODK_NODISCARD std::size_t getFreeSpace() const noexcept
+        {
+            return m_ring_buffer.capacity() - m_ring_buffer.size();
+        }
+
+        ODK_NODISCARD std::size_t getCapacity() const noexcept
+        {
+            return m_ring_buffer.capacity();
+        }
+
+        /**
+         * Consumer: sets the tick of the next sent sample, must not be called while samples are pushed
+         */
+        void reset(std::uint64_t next_tick)
+        {
+            m_ring_buffer.consume([](const T*, std::size_t) {});
+            m_next_tick = next_tick;
+        }
+
+        ODK_NODISCARD std::uint64_t getNextTick() const noexcept
+        {
+            return m_next_tick;
+        }
+
+        /**
+         * Consumer: sends up to max_count available samples to the output channel
+         * @return number of sent samples
+         */
+        std::size_t send(odk::IfHost* host, std::uint32_t local_channel_id, std::size_t max_count = std::numeric_limits<std::size_t>::max())
+        {
+            m_output_buffer.clear();
+            m_ring_buffer.consume([this](const T* samples, std::size_t count)
+                {
+                    const auto offset = m_output_buffer.size();
+                    m_output_buffer.resize(offset + count);
+                    std::copy(samples, samples + count, m_output_buffer.data() + offset);
+                }, max_count);
+
+            const auto count = m_output_buffer.size();
+            if (count > 0)
+            {
+                m_output_buffer.send(host, local_channel_id, m_next_tick, count);
+                m_next_tick += count;
+            }
+            return count;
+        }
+
+    private:
+        SampleRingBuffer<T> m_ring_buffer;
+        ContiguousSampleBuffer<T> m_output_buffer;
+        std::uint64_t m_next_tick;
+    };
+}
+}
@@ -0,0 +1,119 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+
+#include "odkuni_defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * View on scratch memory handed out by ScratchArena
+     * the memory is owned by the arena and stays valid until the arena is reset
+     */
+    template <class T>
+    class ScratchBuffer
+    {
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        ScratchBuffer() noexcept = default;
+
+        ScratchBuffer(T* data, std::size_t size) noexcept
+            : m_data(data)
+            , m_size(size)
+        {
+        }
+
+        ODK_NODISCARD T* data() const noexcept { return m_data; }
+        ODK_NODISCARD std::size_t size() const noexcept { return m_size; }
+        ODK_NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+        ODK_NODISCARD T& operator[](std::size_t index) const noexcept
+        {
+            return m_data[index];
+        }
+
+        ODK_NODISCARD iterator begin() const noexcept { return m_data; }
+        ODK_NODISCARD iterator end() const noexcept { return m_data + m_size; }
+
+    private:
+        T* m_data = nullptr;
+        std::size_t m_size = 0;
+    };
+
+    /**
+     * Bump allocator for temporary buffers of a single processing call
+     * buffers are never freed individually, reset() releases all of them at once but keeps the memory.
+     * When a call needed more than one memory block, reset() replaces them by a single block
+     * large enough for all of them, so repeated calls with similar demand do not allocate.
+     */
+    class ScratchArena
+    {
+    public:
+        static constexpr std::size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+        ScratchArena() = default;
+        explicit ScratchArena(std::size_t initial_capacity);
+
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        /**
+         * Returns an uninitialized buffer of count elements
+         * @throws std::bad_alloc if the size in bytes does not fit into std::size_t
+         */
+        template <class T>
+        ODK_NODISCARD ScratchBuffer<T> allocate(std::size_t count)
+        {
+            static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                "Scratch buffers are released without running destructors");
+            if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_alloc();
+            }
+            return ScratchBuffer<T>(static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T))), count);
+        }
+
+        /**
+         * Returns size bytes of uninitialized memory aligned to alignment (a power of two)
+         * @throws std::bad_alloc if the memory cannot be allocated
+         */
+        ODK_NODISCARD void* allocateBytes(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * Releases all buffers handed out since the last reset
+         */
+        void reset();
+
+        /// Bytes handed out since the last reset, including alignment padding
+        ODK_NODISCARD std::size_t getUsedSize() const noexcept;
+
+        /// Bytes currently owned by the arena
+        ODK_NODISCARD std::size_t getCapacity() const noexcept;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::uint8_t[]> m_memory;
+            std::size_t m_size;
+        };
+
+        void addBlock(std::size_t size);
+
+        std::vector<Block> m_blocks;
+        std::size_t m_offset = 0;       ///< first free byte in the last block
+        std::size_t m_used_size = 0;    ///< bytes handed out including padding, not the unused ends of earlier blocks
+    };
+}
+}
@@ -6,10 +6,15 @@
 #include "odkapi_timestamp_xml.h"
 #include "odkapi_update_channels_xml.h"
 #include "odkbase_basic_values.h"
+#include "odkfw_channel_iterator_table.h"
 #include "odkfw_input_channel.h"
 #include "odkfw_interfaces.h"
+#include "odkfw_scratch_arena.h"
 #include "odkfw_stream_iterator.h"
+#include "odkfw_stream_reader.h"
+#include "odkfw_thread_pool.h"
 
+#include <functional>
 #include <optional>
 #include <set>
 
@@ -29,12 +34,17 @@ namespace framework
         /**
          * ProcessingContext used in process call
          * provides data needed for calculation since last call
+         * the context is reused by the instance, iterators keep their memory across calls
+         * every input channel has a fixed slot in m_channel_iterators from prepareProcessing until stopProcessing
+         * @see getChannelSlot
          */
         struct ProcessingContext
         {
             Timestamp m_master_timestamp;
-            std::map<uint64_t, odk::framework::StreamIterator> m_channel_iterators;
+            ChannelIteratorTable m_channel_iterators;
             std::pair<double, double> m_window;
+            ScratchArena* m_scratch = nullptr;  ///< temporary buffers of the instance, released after the process call
+            WorkStealingThreadPool* m_thread_pool = nullptr;    ///< pool of the plugin used by parallelForChannels
         };
 
         struct InitParams
@@ -162,6 +172,7 @@ namespace framework
          * processing and adding samples to output channels is done in here
          *
          * @param context  time information and sample data of input channels of processing interval
+         * @param host     only valid during this call (a proxy with parallel processing), do not store it
          */
         virtual void process(ProcessingContext& context, odk::IfHost* host) = 0;
 
@@ -282,6 +293,27 @@ namespace framework
         void removeOutputChannel(PluginChannelPtr& channel);
 
         InputChannelPtr getInputChannelProxy(std::uint64_t channel_id);
+
+        /**
+         * Returns the slot of the input channel in ProcessingContext::m_channel_iterators
+         * slots are assigned before prepareProcessing and can be stored for all process calls until stopProcessing
+         *
+         * @return slot or ChannelIteratorTable::NO_SLOT if no data is requested for the channel
+         */
+        std::size_t getChannelSlot(std::uint64_t channel_id) const;
+
+        using ChannelFunction = std::function<void(std::size_t slot, StreamIterator& iterator)>;
+
+        /**
+         * Calls fn for every input channel of the context, distributed over context.m_thread_pool
+         * (on the calling thread if the context has no pool)
+         * returns when all channels are processed, output samples are written afterwards on the calling thread
+         *
+         * the iterators are independent, fn may only touch state of its own channel (e.g. indexed by slot)
+         * fn must not communicate with the host and must not allocate from context.m_scratch
+         * the first exception thrown by fn is rethrown
+         */
+        static void parallelForChannels(ProcessingContext& context, const ChannelFunction& fn);
         InputChannelPtr getInputChannelProxyChecked(std::uint64_t channel_id);
 
 
@@ -388,6 +420,8 @@ namespace framework
 
         void setupDataRequest(odk::IfHost* host);
 
+        void assignChannelSlots();
+
         void updateInternalInputChannelIDs(const std::map<std::uint64_t, std::uint64_t>& changed_ids);
 
         bool handleConfigChange();
@@ -412,7 +446,20 @@ namespace framework
             const odk::Interval<double>& covered_interval,
             const odk::DataRegions& data_regions);
 
+        /**
+         * Points existing iterators to the new data instead of creating new ones
+         */
+        void updateChannelIterators(
+            const std::vector<odk::StreamDescriptor>& stream_descriptor,
+            const odk::IfDataBlockList* block_list,
+            const odk::Interval<double>& covered_interval,
+            const odk::DataRegions& data_regions,
+            ChannelIteratorTable& iterators);
+
     protected:
+        /**
+         * Returns the host, during process() this is the host passed to process()
+         */
         odk::IfHost* getHost();
         std::vector<PluginChannelPtr> m_output_channels;
 
@@ -426,7 +473,11 @@ namespace framework
         std::vector<InputChannelPtr> m_input_channel_proxies;
         std::optional<DataSetDescriptor> m_dataset_descriptor;
         std::vector<const odk::IfDataBlockList*> m_block_lists;
+        StreamReader m_stream_reader;
+        ScratchArena m_scratch_arena;
+        ProcessingContext m_processing_context;
         odk::IfHost* m_host = nullptr;
+        odk::IfHost* m_processing_host = nullptr;   ///< host of the running onProcess call
     };
 
 }
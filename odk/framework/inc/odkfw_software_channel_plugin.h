@@ -51,6 +51,16 @@ namespace framework
         PluginChannelsPtr getPluginChannels();
         std::shared_ptr<odk::framework::CustomRequestHandler> getCustomRequestHandler();
 
+        /**
+         * Runs process() of all instances concurrently on a thread pool
+         * has to be called in the constructor of the plugin, @see PluginChannels::enableParallelProcessing
+         * instances must only talk to the host through the host argument of process() or getHost()
+         * and must not keep that host after process() returned
+         *
+         * @param thread_count  number of worker threads, 0 uses one per hardware thread
+         */
+        void enableParallelProcessing(std::size_t thread_count = 0);
+
         bool checkOxygenCompatibility();
 
         /**
@@ -18,6 +18,53 @@ namespace framework
 {
     class IfIteratorUpdater;
 
+    /**
+     * View on consecutive samples of a single block
+     * allows processing a whole block without per-sample iterator overhead
+     */
+    template<class SampleFormat>
+    struct StreamChunk
+    {
+        const SampleFormat* m_data = nullptr;   ///< first sample of the chunk, nullptr for gaps
+        std::size_t m_count = 0;                ///< number of samples in the chunk
+        std::uint64_t m_first_timestamp = 0;    ///< timestamp of the first sample
+        std::size_t m_stride = 0;               ///< distance between two samples in bytes
+        BlockIterator m_begin;                  ///< position of the first sample, used for timestamp lookup
+
+        ODK_NODISCARD inline bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        ODK_NODISCARD inline bool isGap() const noexcept
+        {
+            return m_data == nullptr;
+        }
+
+        /// True if m_data can be accessed as a plain array of m_count samples
+        ODK_NODISCARD inline bool isContiguous() const noexcept
+        {
+            return m_stride == sizeof(SampleFormat);
+        }
+
+        ODK_NODISCARD inline SampleFormat value(std::size_t index) const noexcept
+        {
+            if (m_data)
+            {
+                return *reinterpret_cast<const SampleFormat*>(
+                    reinterpret_cast<const std::uint8_t*>(m_data) + index * m_stride);
+            }
+            return std::numeric_limits<SampleFormat>::quiet_NaN();
+        }
+
+        ODK_NODISCARD inline std::uint64_t timestamp(std::size_t index) const
+        {
+            BlockIterator it = m_begin;
+            it += index;
+            return it.timestamp();
+        }
+    };
+
     class StreamIterator
     {
     public:
@@ -55,16 +102,37 @@ namespace framework
             return m_block_index >= 0;
         }
 
+        using BlockIteratorRange = std::pair<BlockIterator, BlockIterator>;
+
         void addRange(const BlockIterator& begin, const BlockIterator& end);
 
+        /**
+         * Adds several ranges at once
+         * ranges are sorted once after appending, prefer this over addRange for many ranges
+         * the resulting order is the same as calling addRange for every range in order
+         */
+        void addRanges(std::vector<BlockIteratorRange>&& ranges);
+
         void clearRanges() noexcept;
 
+        /**
+         * Clears the iterator and returns the (empty) range storage for refilling,
+         * passing it back to addRanges reuses the memory instead of allocating
+         */
+        ODK_NODISCARD std::vector<BlockIteratorRange> releaseRanges() noexcept;
+
         void setDataRequester(IfIteratorUpdater* requester) noexcept;
 
         inline StreamIterator& operator++()
         {
             ODK_ASSERT(valid());
-            ++m_current_iterator;
+            // layout is fixed within a block, dispatch to the specialized increment
+            switch (m_layout)
+            {
+                case BlockLayout::IMPLICIT_TIMESTAMP: m_current_iterator.increment<BlockLayout::IMPLICIT_TIMESTAMP>(); break;
+                case BlockLayout::EXPLICIT_TIMESTAMP: m_current_iterator.increment<BlockLayout::EXPLICIT_TIMESTAMP>(); break;
+                case BlockLayout::DYNAMIC_SIZE:       m_current_iterator.increment<BlockLayout::DYNAMIC_SIZE>(); break;
+            }
             if (m_current_iterator == m_blocks_ranges[m_block_index].second)
             {
                 getNextBlock();
@@ -84,6 +152,27 @@ namespace framework
         }
 
 
+        /**
+         * Advances the iterator by count samples
+         * whole blocks are skipped without visiting their samples
+         */
+        StreamIterator& operator+=(std::uint64_t count);
+
+        /**
+         * Positions the iterator at the first sample with a timestamp at or after tick
+         * ranges are located by binary search, samples within a block by
+         * arithmetic (implicit timestamps) or binary search (explicit timestamps)
+         *
+         * @return true if such a sample exists
+         */
+        bool seek(std::uint64_t tick);
+
+        /**
+         * Positions the iterator at the first sample at or after time (in seconds)
+         * @see seek
+         */
+        bool seekTime(double time);
+
         ODK_NODISCARD inline bool operator==(const StreamIterator& other) const noexcept
         {
             return m_current_iterator == other.m_current_iterator;
@@ -94,6 +183,23 @@ namespace framework
             return !(*this == other);
         }
 
+        /**
+         * Returns all remaining samples of the current block (at most max_count) and
+         * advances the iterator behind them
+         * an empty chunk is returned when the iterator is exhausted
+         * samples with dynamic size are returned one at a time
+         */
+        template<class SampleFormat>
+        ODK_NODISCARD StreamChunk<SampleFormat> nextChunk(std::uint64_t max_count = std::numeric_limits<std::uint64_t>::max())
+        {
+            StreamChunk<SampleFormat> chunk;
+            chunk.m_begin = takeChunk(max_count, chunk.m_count);
+            chunk.m_data = static_cast<const SampleFormat*>(chunk.m_begin.data());
+            chunk.m_first_timestamp = chunk.m_begin.timestamp();
+            chunk.m_stride = chunk.m_begin.stride();
+            return chunk;
+        }
+
         void setSignalGaps(bool enabled) noexcept;
         void setSkipGaps(bool enabled);
 
@@ -103,20 +209,31 @@ namespace framework
 
         ODK_NODISCARD std::vector<DataRegion> getDataRegions(double start, double end) const noexcept;
 
-        using BlockIteratorRange = std::pair<BlockIterator, BlockIterator>;
-
         void setTimebase(const odk::Timebase& timebase) noexcept;
         const odk::Timebase& getTimebase() const noexcept;
         double getTime() noexcept;
 
     private:
+        inline void setCurrentIterator(const BlockIterator& iterator) noexcept
+        {
+            m_current_iterator = iterator;
+            m_layout = iterator.layout();
+        }
+
         void getNextBlock();
         void getPreviousBlock();
+        void resetPosition();
+        void updateGaps() const;
+        BlockIterator takeChunk(std::uint64_t max_count, std::size_t& count);
 
     private:
         std::vector<BlockIteratorRange> m_blocks_ranges;
+        /// merged gap intervals [begin, end) in ticks, built on demand by isInGap
+        mutable std::vector<std::pair<std::uint64_t, std::uint64_t>> m_gaps;
+        mutable bool m_gaps_valid;
         int m_block_index;
         BlockIterator m_current_iterator;
+        BlockLayout m_layout;
         IfIteratorUpdater* m_data_requester;
         bool m_signal_gaps;
         bool m_skip_gaps;
@@ -9,9 +9,12 @@
 #include <cstddef>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace odk
 {
+    class IfDataBlockList;
+
 namespace framework
 {
     class StreamReader
@@ -39,6 +42,20 @@ namespace framework
         void addDataBlock(const BlockDescriptor& block_descriptor, const void* data);
         void addDataBlock(BlockDescriptor&& block_descriptor, const void* data);
 
+        /**
+         * Adds a block of data described by its block channels
+         * the block is indexed by every channel it contains
+         */
+        void addDataBlock(std::uint64_t stream_id, std::uint64_t data_size,
+            const BlockChannelDescriptor* block_channels, std::size_t block_channel_count, const void* data);
+
+        /**
+         * Adds all blocks of a block list returned by DATA_READ
+         * block descriptions are parsed into a reused buffer,
+         * descriptions sharing the structure of previous ones are decoded without XML parsing
+         */
+        void addDataBlocks(const odk::IfDataBlockList* block_list);
+
         void addDataRegion(const odk::DataRegion& region);
 
         /**
@@ -57,14 +74,33 @@ namespace framework
          */
         ODK_NODISCARD bool hasChannel(std::uint64_t channel_id) const;
 
+        /**
+         * Returns true if any block containing samples of the channel has been added
+         */
+        ODK_NODISCARD bool hasBlocks(std::uint64_t channel_id) const;
+
         void clearBlocks();
 
     private:
         const ChannelDescriptor* getChannelDescriptor(std::uint64_t channel_id) const;
 
-        using BlockDescriptorData = std::tuple<BlockDescriptor, const void*>;
+        /**
+         * Part of a data block belonging to a single channel
+         */
+        struct BlockSlice
+        {
+            std::uint64_t m_stream_id;
+            std::uint64_t m_data_size;      ///< size of the complete data block in bytes
+            const void* m_data;             ///< start of the complete data block
+            std::size_t m_channel_count;    ///< number of channels sharing the data block
+            BlockChannelDescriptor m_channel;
+        };
+
         StreamDescriptor m_stream_descriptor;
-        std::multimap<std::uint64_t, BlockDescriptorData> m_blocks;
+        /// slices of all blocks in insertion order, per channel id (vectors are kept on clearBlocks to reuse their memory)
+        std::map<std::uint64_t, std::vector<BlockSlice>> m_channel_blocks;
+        BlockDescriptor m_parse_buffer;
+        BlockDescriptorCache m_descriptor_cache;
         std::map<std::uint64_t, std::set<odk::Interval<std::uint64_t>>> m_data_regions;
     };
 }
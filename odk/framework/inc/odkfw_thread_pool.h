@@ -0,0 +1,70 @@
+// Copyright DEWETRON GmbH 2026
+#pragma once
+
+#include "odkuni_defines.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Fixed size thread pool with one job queue per worker
+     * jobs are distributed round robin, idle workers steal from the other queues
+     * so a few long jobs do not leave the rest of the pool waiting.
+     * Exceptions escaping a job are discarded, jobs have to report errors themselves.
+     */
+    class WorkStealingThreadPool
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @param thread_count  number of worker threads, 0 uses one per hardware thread
+         */
+        explicit WorkStealingThreadPool(std::size_t thread_count = 0);
+        ~WorkStealingThreadPool();
+
+        WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+        WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+        ODK_NODISCARD std::size_t getThreadCount() const noexcept;
+
+        void submit(Job job);
+
+        /**
+         * Calls fn(index) for every index in [0, count) and returns when all calls are finished
+         * the calling thread processes indices as well, so nested use from a pool job cannot deadlock
+         * the first exception thrown by fn is rethrown after all calls finished
+         */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t index)>& fn);
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex m_mutex;
+            std::deque<Job> m_jobs;
+        };
+
+        void run(std::size_t index);
+        bool takeJob(std::size_t index, Job& job);
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<std::size_t> m_next_queue;
+        std::atomic<std::size_t> m_queued_jobs;
+        std::mutex m_wake_mutex;
+        std::condition_variable m_wake;
+        bool m_stop;
+    };
+}
+}
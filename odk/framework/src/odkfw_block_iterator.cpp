@@ -60,56 +60,59 @@ namespace framework
     {
     }
 
-    BlockIterator& BlockIterator::operator++()
+    BlockIterator& BlockIterator::operator--()
     {
+        if (m_sample_size)
+        {
+            // In order to step back, we would need to know the size of the previous sample, which we can only find when we know the size of the previous sample
+            throw std::runtime_error("Cannot decrement iterator with dynamic sample sizes");
+            //m_sample_size = reinterpret_cast<const std::uint32_t*>(
+            //    reinterpret_cast<const std::uint8_t*>(m_sample_size) - m_sample_size_stride - m_sample_size_value);
+        }
+
         const std::size_t sample_size = size();
         if (m_data)
         {
-            m_data = reinterpret_cast<const std::uint8_t*>(m_data) + m_data_stride + sample_size;
+            m_data = reinterpret_cast<const std::uint8_t*>(m_data) - m_data_stride - sample_size;
         }
 
         if (m_timestamp)
         {
             m_timestamp = reinterpret_cast<const std::uint64_t*>(
-                reinterpret_cast<const std::uint8_t*>(m_timestamp) + m_timestamp_stride + sample_size);
+                reinterpret_cast<const std::uint8_t*>(m_timestamp) - m_timestamp_stride - sample_size);
         }
         else
         {
-            ++m_timestamp_value;
-        }
-
-        if (m_sample_size)
-        {
-            m_sample_size = reinterpret_cast<const std::uint32_t*>(
-                reinterpret_cast<const std::uint8_t*>(m_sample_size) + m_sample_size_stride + sample_size);
+            --m_timestamp_value;
         }
         return *this;
     }
 
-    BlockIterator& BlockIterator::operator--()
+    BlockIterator& BlockIterator::operator+=(std::uint64_t count)
     {
         if (m_sample_size)
         {
-            // In order to step back, we would need to know the size of the previous sample, which we can only find when we know the size of the previous sample
-            throw std::runtime_error("Cannot decrement iterator with dynamic sample sizes");
-            //m_sample_size = reinterpret_cast<const std::uint32_t*>(
-            //    reinterpret_cast<const std::uint8_t*>(m_sample_size) - m_sample_size_stride - m_sample_size_value);
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                ++(*this);
+            }
+            return *this;
         }
 
-        const std::size_t sample_size = size();
+        const std::size_t offset = static_cast<std::size_t>(count * m_data_stride);
         if (m_data)
         {
-            m_data = reinterpret_cast<const std::uint8_t*>(m_data) - m_data_stride - sample_size;
+            m_data = reinterpret_cast<const std::uint8_t*>(m_data) + offset;
         }
 
         if (m_timestamp)
         {
             m_timestamp = reinterpret_cast<const std::uint64_t*>(
-                reinterpret_cast<const std::uint8_t*>(m_timestamp) - m_timestamp_stride - sample_size);
+                reinterpret_cast<const std::uint8_t*>(m_timestamp) + count * m_timestamp_stride);
         }
         else
         {
-            --m_timestamp_value;
+            m_timestamp_value += count;
         }
         return *this;
     }
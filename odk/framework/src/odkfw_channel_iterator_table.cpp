@@ -0,0 +1,98 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_channel_iterator_table.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace odk
+{
+namespace framework
+{
+    std::size_t ChannelIteratorTable::addChannel(std::uint64_t channel_id)
+    {
+        const auto index = lowerBound(channel_id);
+        if (index != m_slot_index.end() && index->first == channel_id)
+        {
+            return index->second;
+        }
+
+        const std::size_t slot = m_entries.size();
+        m_entries.emplace_back(channel_id, StreamIterator());
+        m_slot_index.emplace(index, channel_id, slot);
+        return slot;
+    }
+
+    std::size_t ChannelIteratorTable::getSlot(std::uint64_t channel_id) const noexcept
+    {
+        const auto index = lowerBound(channel_id);
+        if (index != m_slot_index.end() && index->first == channel_id)
+        {
+            return index->second;
+        }
+        return NO_SLOT;
+    }
+
+    StreamIterator& ChannelIteratorTable::operator[](std::uint64_t channel_id)
+    {
+        return at(channel_id);
+    }
+
+    const StreamIterator& ChannelIteratorTable::operator[](std::uint64_t channel_id) const
+    {
+        return at(channel_id);
+    }
+
+    StreamIterator& ChannelIteratorTable::at(std::uint64_t channel_id)
+    {
+        const auto slot = getSlot(channel_id);
+        if (slot == NO_SLOT)
+        {
+            throw std::out_of_range("Unknown channel ID");
+        }
+        return m_entries[slot].second;
+    }
+
+    const StreamIterator& ChannelIteratorTable::at(std::uint64_t channel_id) const
+    {
+        const auto slot = getSlot(channel_id);
+        if (slot == NO_SLOT)
+        {
+            throw std::out_of_range("Unknown channel ID");
+        }
+        return m_entries[slot].second;
+    }
+
+    ChannelIteratorTable::iterator ChannelIteratorTable::find(std::uint64_t channel_id) noexcept
+    {
+        const auto slot = getSlot(channel_id);
+        return slot == NO_SLOT ? m_entries.end() : m_entries.begin() + slot;
+    }
+
+    ChannelIteratorTable::const_iterator ChannelIteratorTable::find(std::uint64_t channel_id) const noexcept
+    {
+        const auto slot = getSlot(channel_id);
+        return slot == NO_SLOT ? m_entries.end() : m_entries.begin() + slot;
+    }
+
+    std::size_t ChannelIteratorTable::count(std::uint64_t channel_id) const noexcept
+    {
+        return getSlot(channel_id) == NO_SLOT ? 0 : 1;
+    }
+
+    void ChannelIteratorTable::clear() noexcept
+    {
+        m_entries.clear();
+        m_slot_index.clear();
+    }
+
+    ChannelIteratorTable::SlotIndex::const_iterator ChannelIteratorTable::lowerBound(std::uint64_t channel_id) const noexcept
+    {
+        return std::lower_bound(m_slot_index.begin(), m_slot_index.end(), channel_id,
+            [](const SlotIndex::value_type& entry, std::uint64_t id)
+            {
+                return entry.first < id;
+            });
+    }
+}
+}
@@ -397,6 +397,7 @@ namespace framework
         : m_change_listener(l)
         , m_id(id)
         , m_registered(false)
+        , m_group_started(false)
         , m_worker(worker)
         , m_token(token)
         , m_valid(false)
@@ -585,9 +586,29 @@ namespace framework
 
         if (register_tasks)
         {
-            for (auto& task : m_tasks)
+            if (m_executor)
             {
-                registerTask(*task.second);
+                // collect all tasks first to register the group only once
+                bool changed = false;
+                for (auto& task : m_tasks)
+                {
+                    if (!task.second->m_registered && task.second->isValid())
+                    {
+                        task.second->m_registered = true;
+                        changed = true;
+                    }
+                }
+                if (changed)
+                {
+                    updateTaskGroup();
+                }
+            }
+            else
+            {
+                for (auto& task : m_tasks)
+                {
+                    registerTask(*task.second);
+                }
             }
         }
     }
@@ -616,6 +637,15 @@ namespace framework
 
     void PluginChannels::restartTask(PluginTaskPtr& task)
     {
+        if (m_executor)
+        {
+            // the other members of the group keep running, only this worker is restarted
+            stopGroupWorker(*task);
+            task->m_registered = task->isValid();
+            updateTaskGroup();
+            return;
+        }
+
         unregisterTask(*task);
         registerTask(*task);
     }
@@ -627,12 +657,56 @@ namespace framework
 
     void PluginChannels::pauseTasks()
     {
+        if (m_executor)
+        {
+            for (auto& task : m_tasks)
+            {
+                task.second->m_registered = false;
+            }
+            updateTaskGroup();
+            return;
+        }
+
         for (auto& task : m_tasks)
         {
             unregisterTask(*task.second);
         }
     }
 
+    void PluginChannels::enableParallelProcessing(std::size_t thread_count)
+    {
+        ODK_ASSERT(!m_task_group_registered);
+        m_executor = std::make_unique<ParallelTaskExecutor>(thread_count);
+    }
+
+    bool PluginChannels::isParallelProcessingEnabled() const noexcept
+    {
+        return m_executor != nullptr;
+    }
+
+    WorkStealingThreadPool& PluginChannels::getThreadPool()
+    {
+        if (m_executor)
+        {
+            return m_executor->getThreadPool();
+        }
+
+        // instances may be processed concurrently by the host
+        std::lock_guard<std::mutex> lock(m_thread_pool_mutex);
+        if (!m_thread_pool)
+        {
+            m_thread_pool = std::make_unique<WorkStealingThreadPool>();
+        }
+        return *m_thread_pool;
+    }
+
+    void PluginChannels::shutdownThreads()
+    {
+        m_executor.reset();
+        std::lock_guard<std::mutex> lock(m_thread_pool_mutex);
+        m_thread_pool.reset();
+    }
+
     std::set<PluginTaskPtr> PluginChannels::getAffectedTasks(const odk::UpdateConfigTelegram& request)
     {
         std::set<PluginTaskPtr> affected_tasks;
@@ -854,6 +928,16 @@ namespace framework
 
     void PluginChannels::registerTask(PluginTask& task)
     {
+        if (m_executor)
+        {
+            if (!task.m_registered && task.isValid())
+            {
+                task.m_registered = true;
+                updateTaskGroup();
+            }
+            return;
+        }
+
         if (!task.m_registered && task.isValid())
         {
             odk::AddAcquisitionTaskTelegram telegram;
@@ -880,6 +964,16 @@ namespace framework
 
     void PluginChannels::unregisterTask(PluginTask& t)
     {
+        if (m_executor)
+        {
+            if (t.m_registered)
+            {
+                t.m_registered = false;
+                updateTaskGroup();
+            }
+            return;
+        }
+
         if (t.m_registered)
         {
             m_host->messageSync(odk::host_msg::ACQUISITION_TASK_REMOVE, t.m_id, nullptr);
@@ -887,6 +981,157 @@ namespace framework
         }
     }
 
+    bool PluginChannels::updateTaskGroup()
+    {
+        const auto tasks = getGroupTasks();
+
+        odk::AddAcquisitionTaskTelegram telegram;
+        telegram.m_id = TASK_GROUP_ID;
+        telegram.m_block_duration = 0.0;
+
+        std::set<std::uint64_t> input_channels;
+        for (const auto& task : tasks)
+        {
+            // the shortest requested block duration serves all tasks
+            if (task->m_block_duration > 0.0 &&
+                (telegram.m_block_duration <= 0.0 || task->m_block_duration < telegram.m_block_duration))
+            {
+                telegram.m_block_duration = task->m_block_duration;
+            }
+
+            input_channels.insert(task->m_input_channels.begin(), task->m_input_channels.end());
+
+            for (const auto& ch : task->m_output_channels)
+            {
+                telegram.m_output_channels.push_back(ch->getLocalId());
+            }
+        }
+        telegram.m_input_channels.assign(input_channels.begin(), input_channels.end());
+
+        const auto xml = tasks.empty() ? std::string() : telegram.generate();
+        if (xml == m_task_group_xml)
+        {
+            // the host keeps running the group, start the workers that joined it and stop the ones that left
+            for (auto& task : m_tasks)
+            {
+                auto& member = *task.second;
+                if (member.m_registered && member.m_worker && !member.m_group_started && m_task_group_running)
+                {
+                    member.m_worker->onInitTimebases(m_host, member.m_token);
+                    member.m_worker->onStartProcessing(m_host, member.m_token);
+                    member.m_group_started = true;
+                }
+                else if (!member.m_registered)
+                {
+                    stopGroupWorker(member);
+                }
+            }
+            return false;
+        }
+
+        if (m_task_group_registered)
+        {
+            for (auto& task : m_tasks)
+            {
+                stopGroupWorker(*task.second);
+            }
+            m_host->messageSync(odk::host_msg::ACQUISITION_TASK_REMOVE, TASK_GROUP_ID, nullptr);
+            m_task_group_registered = false;
+            m_task_group_running = false;
+        }
+
+        m_task_group_xml = xml;
+        if (tasks.empty())
+        {
+            return true;
+        }
+
+        m_task_group_registered = true;
+
+        auto xml_msg = m_host->createValue<odk::IfXMLValue>();
+        xml_msg->set(xml.c_str());
+        m_host->messageSync(odk::host_msg::ACQUISITION_TASK_ADD, 0, xml_msg.get());
+        return true;
+    }
+
+    void PluginChannels::stopGroupWorker(PluginTask& task)
+    {
+        if (task.m_group_started)
+        {
+            task.m_group_started = false;
+            task.m_worker->onStopProcessing(m_host, task.m_token);
+        }
+    }
+
+    std::vector<PluginTaskPtr> PluginChannels::getGroupTasks() const
+    {
+        std::vector<PluginTaskPtr> tasks;
+        for (const auto& task : m_tasks)
+        {
+            if (task.second->m_registered && task.second->m_worker)
+            {
+                tasks.push_back(task.second);
+            }
+        }
+        return tasks;
+    }
+
+    std::uint64_t PluginChannels::processTaskGroup(odk::PluginMessageId id, const odk::IfValue* param)
+    {
+        const auto tasks = getGroupTasks();
+        switch (id)
+        {
+        case odk::plugin_msg::ACQUISITION_TASK_INIT_TIMEBASES:
+            for (const auto& task : tasks)
+            {
+                task->m_worker->onInitTimebases(m_host, task->m_token);
+            }
+            break;
+        case odk::plugin_msg::ACQUISITION_TASK_START_PROCESSING:
+            m_task_group_running = true;
+            for (const auto& task : tasks)
+            {
+                task->m_worker->onStartProcessing(m_host, task->m_token);
+                task->m_group_started = true;
+            }
+            break;
+        case odk::plugin_msg::ACQUISITION_TASK_STOP_PROCESSING:
+            m_task_group_running = false;
+            for (auto& task : m_tasks)
+            {
+                stopGroupWorker(*task.second);
+            }
+            break;
+        case odk::plugin_msg::ACQUISITION_TASK_PROCESS:
+        {
+            auto process_xml = odk::value_cast<const odk::IfXMLValue>(param);
+
+            std::vector<ParallelTaskExecutor::Job> jobs;
+            jobs.reserve(tasks.size());
+            for (const auto& task : tasks)
+            {
+                jobs.emplace_back([&task, process_xml](odk::IfHost* host)
+                    {
+                        task->m_worker->onProcess(host, task->m_token, process_xml);
+                    });
+            }
+
+            try
+            {
+                m_executor->run(m_host, jobs);
+            }
+            catch (...)
+            {
+                return odk::error_codes::UNHANDLED_EXCEPTION;
+            }
+            break;
+        }
+        default:
+            return odk::error_codes::NOT_IMPLEMENTED;
+        }
+        return odk::error_codes::OK;
+    }
+
     void PluginChannels::onChannelPropertyChanged(const PluginChannel* channel, const std::string& name)
     {
         ODK_UNUSED(name);
@@ -904,6 +1149,20 @@ namespace framework
         ODK_UNUSED(ret);
         try
         {
+            if (m_executor && key == TASK_GROUP_ID)
+            {
+                switch (id)
+                {
+                case odk::plugin_msg::ACQUISITION_TASK_INIT_TIMEBASES:
+                case odk::plugin_msg::ACQUISITION_TASK_START_PROCESSING:
+                case odk::plugin_msg::ACQUISITION_TASK_STOP_PROCESSING:
+                case odk::plugin_msg::ACQUISITION_TASK_PROCESS:
+                    return processTaskGroup(id, param);
+                default:
+                    break;
+                }
+            }
+
             switch (id)
             {
             case odk::plugin_msg::ACQUISITION_TASK_INIT_TIMEBASES:
@@ -0,0 +1,136 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_data_region_cache.h"
+
+#include <algorithm>
+
+namespace odk
+{
+namespace framework
+{
+    DataRegionCache::DataRegionCache() noexcept
+        : m_channels()
+        , m_interval()
+    {
+    }
+
+    void DataRegionCache::setTickDuration(std::uint64_t channel_id, double tick_duration)
+    {
+        m_channels[channel_id].m_tick_duration = tick_duration;
+    }
+
+    void DataRegionCache::assign(const std::vector<DataRegion>& regions, double start, double end)
+    {
+        for (auto& channel : m_channels)
+        {
+            channel.second.m_regions.clear();
+        }
+
+        for (const auto& region : regions)
+        {
+            auto channel = m_channels.find(region.m_channel_id);
+            if (channel != m_channels.end() && channel->second.m_tick_duration > 0.0)
+            {
+                channel->second.m_regions.push_back(region.m_region);
+            }
+        }
+
+        for (auto& channel : m_channels)
+        {
+            auto& channel_regions = channel.second.m_regions;
+            std::sort(channel_regions.begin(), channel_regions.end());
+
+            // merge overlapping regions, so regions are ordered by start and by end
+            std::size_t merged = 0;
+            for (std::size_t i = 1; i < channel_regions.size(); ++i)
+            {
+                if (channel_regions[i].m_begin < channel_regions[merged].m_end)
+                {
+                    channel_regions[merged].m_end = std::max(channel_regions[merged].m_end, channel_regions[i].m_end);
+                }
+                else
+                {
+                    channel_regions[++merged] = channel_regions[i];
+                }
+            }
+            if (!channel_regions.empty())
+            {
+                channel_regions.resize(merged + 1);
+            }
+        }
+
+        m_interval = Interval<double>(start, end);
+    }
+
+    void DataRegionCache::clear()
+    {
+        m_channels.clear();
+        m_interval.reset();
+    }
+
+    bool DataRegionCache::covers(double start, double end) const noexcept
+    {
+        return m_interval && m_interval->m_begin <= start && end <= m_interval->m_end;
+    }
+
+    std::vector<DataRegion> DataRegionCache::getRegions(double start, double end) const
+    {
+        std::vector<DataRegion> regions;
+        for (const auto& channel : m_channels)
+        {
+            appendRegions(channel.first, channel.second, start, end, regions);
+        }
+        return regions;
+    }
+
+    std::vector<DataRegion> DataRegionCache::getRegions(std::uint64_t channel_id, double start, double end) const
+    {
+        std::vector<DataRegion> regions;
+        auto channel = m_channels.find(channel_id);
+        if (channel != m_channels.end())
+        {
+            appendRegions(channel_id, channel->second, start, end, regions);
+        }
+        return regions;
+    }
+
+    std::optional<double> DataRegionCache::getNextRegionStart(double position) const
+    {
+        std::optional<double> next_start;
+        for (const auto& channel : m_channels)
+        {
+            const auto tick_duration = channel.second.m_tick_duration;
+            const auto& channel_regions = channel.second.m_regions;
+            auto region = std::lower_bound(channel_regions.begin(), channel_regions.end(), position,
+                [tick_duration](const Interval<std::uint64_t>& a_region, double time)
+                {
+                    return static_cast<double>(a_region.m_begin) * tick_duration < time;
+                });
+            if (region != channel_regions.end())
+            {
+                const double region_start = static_cast<double>(region->m_begin) * tick_duration;
+                if (!next_start || region_start < *next_start)
+                {
+                    next_start = region_start;
+                }
+            }
+        }
+        return next_start;
+    }
+
+    void DataRegionCache::appendRegions(std::uint64_t channel_id, const ChannelRegions& channel, double start, double end, std::vector<DataRegion>& regions)
+    {
+        // regions touching the window are included
+        const auto tick_duration = channel.m_tick_duration;
+        auto region = std::lower_bound(channel.m_regions.begin(), channel.m_regions.end(), start,
+            [tick_duration](const Interval<std::uint64_t>& a_region, double time)
+            {
+                return static_cast<double>(a_region.m_end) * tick_duration < time;
+            });
+        for (; region != channel.m_regions.end() && static_cast<double>(region->m_begin) * tick_duration <= end; ++region)
+        {
+            regions.emplace_back(channel_id, *region);
+        }
+    }
+}
+}
@@ -5,30 +5,234 @@
 #include "odkapi_oxygen_queries.h"
 #include "odkapi_channel_dataformat_xml.h"
 #include "odkfw_input_channel.h"
+#include "odkuni_assert.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace odk
 {
 namespace framework
 {
+    namespace
+    {
+        std::vector<DataRegion> requestDataRegions(odk::IfHost* host, std::uint64_t data_set_id, double start, double end)
+        {
+            std::shared_ptr<odk::DataRegions> data_regions;
+            {
+                auto xml_msg = host->createValue<odk::IfXMLValue>();
+                if (xml_msg)
+                {
+                    PluginDataRegionsRequest req(data_set_id);
+                    req.m_data_window = PluginDataRegionsRequest::DataWindow(start, end);
+                    xml_msg->set(req.generate().c_str());
+                }
+
+                const odk::IfValue* data_regions_result = nullptr;
+                host->messageSync(odk::host_msg::DATA_REGIONS_READ, 0, xml_msg.get(), &data_regions_result);
+
+                const odk::IfXMLValue* data_regions_result_xml = odk::value_cast<odk::IfXMLValue>(data_regions_result);
+                if (data_regions_result)
+                {
+                    if (data_regions_result_xml)
+                    {
+                        data_regions = std::make_shared<DataRegions>();
+                        data_regions->parse(data_regions_result_xml->asStringView());
+                    }
+                    data_regions_result->release();
+                }
+            }
+            if (data_regions)
+            {
+                return data_regions->m_data_regions;
+            }
+            return {};
+        }
+
+        /**
+         * Duration of a sample tick of the channel as used by the data set, 0 if the timebase is unknown
+         */
+        double getTickDuration(const InputChannel& channel, bool user_reduced, std::uint64_t ratio)
+        {
+            const double frequency = channel.getTimeBase().m_frequency;
+            if (frequency <= 0.0)
+            {
+                return 0.0;
+            }
+            return (user_reduced && ratio > 0 ? static_cast<double>(ratio) : 1.0) / frequency;
+        }
+
+        std::uint64_t getDataSize(const odk::IfDataBlockList* block_list)
+        {
+            std::uint64_t data_size = 0;
+            if (block_list)
+            {
+                const auto block_count = block_list->getBlockCount();
+                for (int i = 0; i < block_count; ++i)
+                {
+                    auto block = odk::ptr(block_list->getBlock(i));
+                    data_size += static_cast<std::uint64_t>(block->dataSize());
+                }
+            }
+            return data_size;
+        }
+
+        struct ChannelRequestInfo
+        {
+            bool m_single_value = false;
+            std::uint64_t m_ratio = 0;
+            /// rate of the requested (raw or reduced) samples, 0 if unknown
+            double m_sample_rate = 0.0;
+            /// estimated size of one requested sample in bytes
+            double m_sample_size = sizeof(double);
+        };
+
+        ChannelRequestInfo queryChannelRequestInfo(odk::IfHost* host, std::uint64_t channel_id, bool user_reduced)
+        {
+            ChannelRequestInfo info;
+
+            std::string channel_context = odk::queries::OxygenChannels + ("#" + odk::to_string(channel_id));
+            auto data_format_xml = host->getValue<IfXMLValue>(channel_context.c_str(), "DataFormat");
+            odk::ChannelDataformat dataformat;
+            if (data_format_xml && dataformat.parse(data_format_xml->asStringView()))
+            {
+                info.m_single_value = dataformat.m_sample_occurrence == odk::ChannelDataformat::SampleOccurrence::SINGLE_VALUE;
+                // scaled data is delivered as doubles
+                if (dataformat.m_sample_dimension != 0 && dataformat.m_sample_dimension != 0xffffffff)
+                {
+                    info.m_sample_size *= dataformat.m_sample_dimension;
+                }
+            }
+
+            if (user_reduced)
+            {
+                auto ratio_response = host->getValue<IfUIntValue>(channel_context.c_str(), "ReducedRatio");
+                if (ratio_response)
+                {
+                    info.m_ratio = ratio_response->getValue();
+                }
+                // reduced samples carry min, max, avg and rms
+                info.m_sample_size *= 4;
+            }
+
+            auto sr_response = host->getValue<IfScalarValue>(channel_context.c_str(), "SampleRate");
+            if (sr_response && sr_response->getValue() > 0)
+            {
+                info.m_sample_rate = sr_response->getValue();
+                if (user_reduced && info.m_ratio > 0)
+                {
+                    info.m_sample_rate /= static_cast<double>(info.m_ratio);
+                }
+            }
+            return info;
+        }
+
+        void removeDataGroup(odk::IfHost* host, std::uint64_t data_set_id)
+        {
+            auto msg = host->createValue<odk::IfUIntValue>();
+            msg->set(data_set_id);
+            host->messageSync(odk::host_msg::DATA_GROUP_REMOVE, 0, msg.get(), nullptr);
+        }
+    }
+
     uint64_t DataRequestIDManager::m_next_id = 0;
 
+    std::vector<DataRegion> getBlockListDataRegions(odk::IfHost* host, std::uint64_t data_set_id,
+        const BlockListDescriptor& block_list_descriptor, double start, double end)
+    {
+        if (block_list_descriptor.m_data_regions)
+        {
+            return *block_list_descriptor.m_data_regions;
+        }
+        return requestDataRegions(host, data_set_id, start, end);
+    }
+
+    std::vector<DataRegion> getBlockListDataRegions(odk::IfHost* host, std::uint64_t data_set_id,
+        const odk::IfDataBlockList* block_list, double start, double end)
+    {
+        if (block_list)
+        {
+            auto block_list_descriptor_xml = odk::ptr(block_list->getBlockListDescription());
+            BlockListDescriptor block_list_descriptor;
+            if (block_list_descriptor_xml && block_list_descriptor.parse(block_list_descriptor_xml->asStringView()))
+            {
+                return getBlockListDataRegions(host, data_set_id, block_list_descriptor, start, end);
+            }
+        }
+        return requestDataRegions(host, data_set_id, start, end);
+    }
+
+    DataWindowSizer::DataWindowSizer(double initial_interval, std::uint64_t target_bytes, double target_latency)
+        : m_interval(initial_interval)
+        , m_min_interval(0.0)
+        , m_max_interval(std::numeric_limits<double>::infinity())
+        , m_target_bytes(target_bytes)
+        , m_target_latency(target_latency)
+    {
+    }
+
+    void DataWindowSizer::setLimits(double min_interval, double max_interval)
+    {
+        m_min_interval = min_interval;
+        m_max_interval = std::max(min_interval, max_interval);
+        m_interval = clamp(m_interval);
+    }
+
+    void DataWindowSizer::setExpectedRate(double bytes_per_second)
+    {
+        if (bytes_per_second > 0)
+        {
+            m_interval = clamp(static_cast<double>(m_target_bytes) / bytes_per_second);
+        }
+    }
+
+    void DataWindowSizer::update(double interval, std::uint64_t received_bytes, double latency)
+    {
+        if (interval <= 0)
+        {
+            return;
+        }
+
+        double next = interval * MAX_STEP;
+        if (received_bytes > 0)
+        {
+            next = std::min(next, interval * static_cast<double>(m_target_bytes) / static_cast<double>(received_bytes));
+        }
+        if (latency > m_target_latency)
+        {
+            next = std::min(next, interval * m_target_latency / latency);
+        }
+        m_interval = clamp(std::max(next, interval / MAX_STEP));
+    }
+
+    double DataWindowSizer::getInterval() const noexcept
+    {
+        return m_interval;
+    }
+
+    double DataWindowSizer::clamp(double interval) const noexcept
+    {
+        return std::min(std::max(interval, m_min_interval), m_max_interval);
+    }
+
     DataRequester::DataRequester(IfHost *host, std::shared_ptr<InputChannel> channel, bool user_reduced)
         : m_host(host)
         , m_current_position(-1)
         , m_channel(channel)
         , m_is_single_value(false)
         , m_user_reduced(user_reduced)
-        , m_data_request_interval(DEFAULT_REQUEST_INTERVAL)
+        , m_window_sizer(DEFAULT_REQUEST_INTERVAL)
         , m_ratio(0)
+        , m_prefetch_enabled(false)
     {
         setupDataRequest();
     }
 
     DataRequester::~DataRequester()
     {
-        auto msg = m_host->createValue<odk::IfUIntValue>();
-        msg->set(m_dataset_descriptor.m_id);
-        m_host->messageSync(odk::host_msg::DATA_GROUP_REMOVE, 0, msg.get(), nullptr);
+        cancelPrefetch();
+        removeDataGroup(m_host, m_dataset_descriptor.m_id);
     }
 
     void DataRequester::setupDataRequest()
@@ -64,92 +268,113 @@ namespace framework
             m_stream_reader.setStreamDescriptor(m_dataset_descriptor.m_stream_descriptors.at(0));
         }
 
-        std::string channel_context = odk::queries::OxygenChannels + ("#" + odk::to_string(m_channel->getChannelId()));
-        auto data_format_xml = m_host->getValue<IfXMLValue>(channel_context.c_str(), "DataFormat");
-        odk::ChannelDataformat dataformat;
-        if (dataformat.parse(data_format_xml->asStringView()))
+        const auto channel_info = queryChannelRequestInfo(m_host, m_channel->getChannelId(), m_user_reduced);
+        m_is_single_value = channel_info.m_single_value;
+        m_ratio = channel_info.m_ratio;
+        if (channel_info.m_sample_rate > 0)
         {
-            m_is_single_value = dataformat.m_sample_occurrence == odk::ChannelDataformat::SampleOccurrence::SINGLE_VALUE;
+            m_window_sizer.setLimits(BLOCK_SIZE / channel_info.m_sample_rate, std::numeric_limits<double>::infinity());
+            m_window_sizer.setExpectedRate(channel_info.m_sample_rate * channel_info.m_sample_size);
         }
+    }
 
-        auto sr_response = m_host->getValue<IfScalarValue>(channel_context.c_str(), "SampleRate");
+    void DataRequester::setPrefetchEnabled(bool enabled)
+    {
+        m_prefetch_enabled = enabled;
+        if (!enabled)
+        {
+            cancelPrefetch();
+        }
+    }
 
-        if (sr_response)
+    bool DataRequester::isPrefetchEnabled() const noexcept
+    {
+        return m_prefetch_enabled;
+    }
+
+    void DataRequester::fetchMoreData()
+    {
+        m_stream_reader.clearBlocks();
+        m_previous_data_block_list = std::move(m_data_block_list);
+
+        DataWindow window = m_prefetch.valid() ? m_prefetch.get() : readWindow(m_current_position, m_window_sizer.getInterval());
+        if (window.m_read_bytes > 0)
         {
-            m_data_request_interval = SAMPLES_PER_REQUEST / sr_response->getValue();
+            m_window_sizer.update(window.m_read_interval, window.m_read_bytes, window.m_read_latency);
         }
 
-        if (m_user_reduced)
+        m_data_block_list = std::move(window.m_data_block_list);
+        m_stream_reader.addDataBlocks(m_data_block_list.get());
+        for (const auto& valid_region : window.m_data_regions)
         {
-            auto ratio_response = m_host->getValue<IfUIntValue>(channel_context.c_str(), "ReducedRatio");
-            if (ratio_response)
-            {
-                m_ratio = ratio_response->getValue();
-                if (m_ratio > 0)
-                {
-                    m_data_request_interval *= m_ratio;
-                }
-            }
+            m_stream_reader.addDataRegion(valid_region);
+        }
+        m_current_position = window.m_end_position;
+
+        if (window.m_complete)
+        {
+            startPrefetch();
         }
     }
 
-    void DataRequester::fetchMoreData()
+    DataRequester::DataWindow DataRequester::readWindow(double position, double interval) const
     {
-        m_stream_reader.clearBlocks();
-        m_data_block_list.reset();
+        DataWindow window;
+        window.m_end_position = position;
 
-        while (m_current_position != m_end_position
-            && (!m_data_block_list || m_data_block_list->getBlockCount() == 0))
+        while (position != m_end_position
+            && (!window.m_data_block_list || window.m_data_block_list->getBlockCount() == 0))
         {
-            double next_position = std::min(m_current_position + m_data_request_interval, m_end_position);
+            double next_position = std::min(position + interval, m_end_position);
 
             if (auto xml_msg = m_host->createValue<odk::IfXMLValue>())
             {
                 if (m_is_single_value)
                 {
                     PluginDataRequest req(m_dataset_descriptor.m_id, odk::PluginDataRequest::SingleValue(std::numeric_limits<double>::max()));
+                    if (!m_region_cache.covers(position, next_position))
+                    {
+                        req.m_include_data_regions = true;
+                    }
                     xml_msg->set(req.generate().c_str());
                 }
                 else
                 {
-                    PluginDataRequest req(m_dataset_descriptor.m_id, PluginDataRequest::DataWindow(m_current_position, next_position));
+                    PluginDataRequest req(m_dataset_descriptor.m_id, PluginDataRequest::DataWindow(position, next_position));
+                    if (!m_region_cache.covers(position, next_position))
+                    {
+                        req.m_include_data_regions = true;
+                    }
                     xml_msg->set(req.generate().c_str());
                 }
 
                 const odk::IfValue* response = nullptr;
+                const auto request_start = std::chrono::steady_clock::now();
                 if (0 != m_host->messageSync(odk::host_msg::DATA_READ, 0, xml_msg.get(), &response))
                 {
-                    return;
+                    window.m_complete = false;
+                    return window;
                 }
 
-                m_data_block_list = odk::ptr(odk::value_cast<odk::IfDataBlockList>(response));
+                window.m_data_block_list = odk::ptr(odk::value_cast<odk::IfDataBlockList>(response));
+                window.m_read_latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - request_start).count();
+                window.m_read_interval = next_position - position;
+                window.m_read_bytes = getDataSize(window.m_data_block_list.get());
             }
 
-            const auto block_count = m_data_block_list->getBlockCount();
-
-            auto block_list_descriptor_xml = odk::ptr(m_data_block_list->getBlockListDescription());
-            BlockListDescriptor list_descriptor;
-            list_descriptor.parse(block_list_descriptor_xml->asStringView());
+            auto data_regions = m_region_cache.covers(position, next_position)
+                ? m_region_cache.getRegions(position, next_position)
+                : getBlockListDataRegions(m_host, m_dataset_descriptor.m_id, window.m_data_block_list.get(), position, next_position);
 
-            for (int i = 0; i < block_count; ++i)
+            if (data_regions.empty() && m_region_cache.covers(position, m_end_position))
             {
-                auto block = odk::ptr(m_data_block_list->getBlock(i));
-                auto block_descriptor_xml = odk::ptr(block->getBlockDescription());
-
-                BlockDescriptor block_descriptor;
-                block_descriptor.parse(block_descriptor_xml->asStringView());
-
-                if (!block_descriptor.m_block_channels.empty())
-                {
-                    m_stream_reader.addDataBlock(std::move(block_descriptor), block->data());
-                }
+                // continue at the next region, or stop if there is none
+                const auto next_region_start = m_region_cache.getNextRegionStart(position);
+                next_position = next_region_start ? std::min(m_end_position, *next_region_start) : m_end_position;
             }
-
-            auto data_regions = getDataRegions(m_current_position, next_position);
-
-            if (data_regions.empty())
+            else if (data_regions.empty())
             {
-                auto regions = getDataRegions(m_current_position, m_end_position);
+                auto regions = requestDataRegions(m_host, m_dataset_descriptor.m_id, position, m_end_position);
                 if (!regions.empty())
                 {
                     if (m_user_reduced)
@@ -160,7 +385,7 @@ namespace framework
                     else
                     {
                         auto next_region_start = (regions.front().m_region.m_begin / m_channel->getTimeBase().m_frequency);
-                        if (next_region_start >= m_current_position)
+                        if (next_region_start >= position)
                         {
                             next_position = std::min(m_end_position, next_region_start);
                         }
@@ -178,13 +403,30 @@ namespace framework
             }
             else
             {
-                for (const auto& valid_region : data_regions)
-                {
-                    m_stream_reader.addDataRegion(valid_region);
-                }
+                window.m_data_regions.insert(window.m_data_regions.end(), data_regions.begin(), data_regions.end());
             }
 
-            m_current_position = next_position;
+            position = next_position;
+            window.m_end_position = position;
+        }
+        return window;
+    }
+
+    void DataRequester::startPrefetch()
+    {
+        if (m_prefetch_enabled && !m_prefetch.valid() && m_current_position != m_end_position)
+        {
+            m_prefetch = std::async(std::launch::async, &DataRequester::readWindow, this, m_current_position, m_window_sizer.getInterval());
+        }
+    }
+
+    void DataRequester::cancelPrefetch()
+    {
+        if (m_prefetch.valid())
+        {
+            // the host request cannot be aborted, wait for it and drop the result
+            m_prefetch.wait();
+            m_prefetch = {};
         }
     }
 
@@ -200,16 +442,14 @@ namespace framework
 
     std::shared_ptr<StreamIterator> DataRequester::getIterator(double start, double end)
     {
-        m_current_position = start;
-        m_end_position = end;
-
         auto timebase = m_channel->getTimeBase();
         if (m_user_reduced)
         {
             timebase.m_frequency /= m_ratio;
-            m_current_position -= (1 / timebase.m_frequency);
+            start -= (1 / timebase.m_frequency);
         }
 
+        resetPosition(start, end);
         fetchMoreData();
 
         if(!m_iterator)
@@ -221,37 +461,558 @@ namespace framework
         return m_iterator;
     }
 
+    void DataRequester::resetPosition(double position, double end)
+    {
+        cancelPrefetch();
+
+        m_current_position = position;
+        m_end_position = end;
+        updateRegionCache(m_current_position, m_end_position);
+    }
+
     std::vector<DataRegion> DataRequester::getDataRegions(double start, double end)
     {
-        std::shared_ptr<odk::DataRegions> data_regions;
+        return readDataRegions(start, end);
+    }
+
+    std::vector<DataRegion> DataRequester::readDataRegions(double start, double end) const
+    {
+        if (m_region_cache.covers(start, end))
+        {
+            return m_region_cache.getRegions(start, end);
+        }
+        return requestDataRegions(m_host, m_dataset_descriptor.m_id, start, end);
+    }
+
+    void DataRequester::updateRegionCache(double start, double end)
+    {
+        m_region_cache.clear();
+        const auto tick_duration = getTickDuration(*m_channel, m_user_reduced, m_ratio);
+        if (tick_duration > 0.0)
+        {
+            m_region_cache.setTickDuration(m_channel->getChannelId(), tick_duration);
+            m_region_cache.assign(requestDataRegions(m_host, m_dataset_descriptor.m_id, start, end), start, end);
+        }
+    }
+
+    MultiChannelDataRequester::ChannelUpdater::ChannelUpdater(MultiChannelDataRequester& requester, std::shared_ptr<InputChannel> channel)
+        : m_requester(requester)
+        , m_channel(std::move(channel))
+        , m_ratio(0)
+        , m_stream(nullptr)
+        , m_current_window(NO_WINDOW)
+        , m_previous_window(NO_WINDOW)
+        , m_next_window(0)
+    {
+    }
+
+    void MultiChannelDataRequester::ChannelUpdater::updateStreamIterator(StreamIterator* iterator)
+    {
+        m_requester.updateChannelIterator(*this, *iterator);
+    }
+
+    std::vector<DataRegion> MultiChannelDataRequester::ChannelUpdater::getDataRegions(double start, double end)
+    {
+        if (m_requester.m_region_cache.covers(start, end))
+        {
+            return m_requester.m_region_cache.getRegions(m_channel->getChannelId(), start, end);
+        }
+
+        auto data_regions = m_requester.getDataRegions(start, end);
+        const auto channel_id = m_channel->getChannelId();
+        data_regions.erase(std::remove_if(data_regions.begin(), data_regions.end(),
+            [channel_id](const DataRegion& region)
+            {
+                return region.m_channel_id != channel_id;
+            }), data_regions.end());
+        return data_regions;
+    }
+
+    MultiChannelDataRequester::MultiChannelDataRequester(odk::IfHost* host, const std::vector<std::shared_ptr<InputChannel>>& channels, bool user_reduced)
+        : m_host(host)
+        , m_user_reduced(user_reduced)
+        , m_end_position(0)
+        , m_window_sizer(DEFAULT_REQUEST_INTERVAL)
+        , m_prefetch_enabled(false)
+        , m_read_count(0)
+    {
+        for (const auto& channel : channels)
+        {
+            m_channels.emplace(channel->getChannelId(), std::make_unique<ChannelUpdater>(*this, channel));
+        }
+        setupDataRequest();
+    }
+
+    MultiChannelDataRequester::~MultiChannelDataRequester()
+    {
+        cancelPrefetch();
+        removeDataGroup(m_host, m_dataset_descriptor.m_id);
+    }
+
+    void MultiChannelDataRequester::setupDataRequest()
+    {
+        PluginDataSet request;
+        request.m_id = DataRequestIDManager::getNextID();
+        request.m_data_set_type = DataSetType::SCALED;
+        request.m_data_mode = m_user_reduced ? DataSetMode::REDUCED : DataSetMode::NORMAL;
+        request.m_policy = StreamPolicy::EXACT;
+        for (const auto& channel : m_channels)
+        {
+            request.m_channels.push_back(channel.first);
+        }
+
+        auto xml_msg = m_host->createValue<odk::IfXMLValue>();
+        if (!xml_msg)
+        {
+            return;
+        }
+
+        xml_msg->set(request.generate().c_str());
+
+        odk::MessageReturnValueHolder<odk::IfXMLValue> group_add_result;
+        m_host->messageSync(odk::host_msg::DATA_GROUP_ADD, 0, xml_msg.get(), group_add_result.data());
+
+        if (group_add_result.valid())
+        {
+            m_dataset_descriptor = DataSetDescriptor();
+            m_dataset_descriptor.parse(group_add_result->asStringView());
+        }
+
+        for (const auto& stream : m_dataset_descriptor.m_stream_descriptors)
+        {
+            for (const auto& channel_descriptor : stream.m_channel_descriptors)
+            {
+                auto channel = m_channels.find(channel_descriptor.m_channel_id);
+                if (channel != m_channels.end())
+                {
+                    channel->second->m_stream = &stream;
+                }
+            }
+        }
+
+        double data_rate = 0.0;
+        double max_sample_rate = 0.0;
+        for (auto& channel : m_channels)
+        {
+            const auto channel_info = queryChannelRequestInfo(m_host, channel.first, m_user_reduced);
+            channel.second->m_ratio = channel_info.m_ratio;
+            data_rate += channel_info.m_sample_rate * channel_info.m_sample_size;
+            max_sample_rate = std::max(max_sample_rate, channel_info.m_sample_rate);
+        }
+        if (max_sample_rate > 0)
+        {
+            m_window_sizer.setLimits(BLOCK_SIZE / max_sample_rate, std::numeric_limits<double>::infinity());
+            m_window_sizer.setExpectedRate(data_rate);
+        }
+    }
+
+    void MultiChannelDataRequester::setPrefetchEnabled(bool enabled)
+    {
+        m_prefetch_enabled = enabled;
+        if (!enabled)
+        {
+            cancelPrefetch();
+        }
+    }
+
+    bool MultiChannelDataRequester::isPrefetchEnabled() const noexcept
+    {
+        return m_prefetch_enabled;
+    }
+
+    std::map<std::uint64_t, std::shared_ptr<StreamIterator>> MultiChannelDataRequester::getIterators(double start, double end)
+    {
+        cancelPrefetch();
+        clearWindows();
+
+        m_end_position = end;
+
+        // reduced data starts one reduced sample early, like in DataRequester::getIterator
+        double first_position = start;
+        for (const auto& channel : m_channels)
+        {
+            if (m_user_reduced && channel.second->m_ratio > 0)
+            {
+                const double reduced_frequency = channel.second->m_channel->getTimeBase().m_frequency / channel.second->m_ratio;
+                first_position = std::min(first_position, start - 1 / reduced_frequency);
+            }
+        }
+        m_window_bounds.assign(1, first_position);
+        updateRegionCache(first_position, end);
+
+        std::map<std::uint64_t, std::shared_ptr<StreamIterator>> iterators;
+        for (auto& channel : m_channels)
+        {
+            ChannelUpdater& updater = *channel.second;
+            if (!updater.m_stream)
+            {
+                continue;
+            }
+
+            updater.m_current_window = NO_WINDOW;
+            updater.m_previous_window = NO_WINDOW;
+            updater.m_next_window = 0;
+            updater.m_fallback.reset();
+
+            auto timebase = updater.m_channel->getTimeBase();
+            if (m_user_reduced && updater.m_ratio > 0)
+            {
+                timebase.m_frequency /= updater.m_ratio;
+            }
+
+            if (!updater.m_iterator)
+            {
+                updater.m_iterator = std::make_shared<StreamIterator>();
+            }
+            updater.m_iterator->setTimebase(timebase);
+            updater.m_iterator->setDataRequester(&updater);
+            try
+            {
+                updateChannelIterator(updater, *updater.m_iterator);
+            }
+            catch (const std::exception&)
+            {
+                // no valid data for this channel
+                updater.m_iterator->clearRanges();
+                continue;
+            }
+
+            iterators.emplace(channel.first, updater.m_iterator);
+        }
+        return iterators;
+    }
+
+    std::vector<DataRegion> MultiChannelDataRequester::getDataRegions(double start, double end) const
+    {
+        return readDataRegions(start, end);
+    }
+
+    std::vector<DataRegion> MultiChannelDataRequester::readDataRegions(double start, double end) const
+    {
+        if (m_region_cache.covers(start, end))
+        {
+            return m_region_cache.getRegions(start, end);
+        }
+        return requestDataRegions(m_host, m_dataset_descriptor.m_id, start, end);
+    }
+
+    void MultiChannelDataRequester::updateRegionCache(double start, double end)
+    {
+        m_region_cache.clear();
+        for (const auto& channel : m_channels)
         {
+            const auto tick_duration = getTickDuration(*channel.second->m_channel, m_user_reduced, channel.second->m_ratio);
+            if (tick_duration <= 0.0)
+            {
+                // regions of this channel cannot be looked up by time, a cache without them would report no valid data
+                // for the channel, so nothing is cached and the regions are requested per window for all channels
+                m_region_cache.clear();
+                return;
+            }
+            m_region_cache.setTickDuration(channel.first, tick_duration);
+        }
+        m_region_cache.assign(requestDataRegions(m_host, m_dataset_descriptor.m_id, start, end), start, end);
+    }
+
+    std::uint64_t MultiChannelDataRequester::getReadCount() const noexcept
+    {
+        return m_read_count.load(std::memory_order_relaxed);
+    }
+
+    void MultiChannelDataRequester::updateChannelIterator(ChannelUpdater& channel, StreamIterator& iterator)
+    {
+        if (channel.m_fallback)
+        {
+            // chunks of the last shared window are not referenced anymore
+            channel.m_previous_window = NO_WINDOW;
+            channel.m_fallback->updateStreamIterator(&iterator);
+            releaseWindows();
+            return;
+        }
+
+        iterator.clearRanges();
+
+        const auto channel_id = channel.m_channel->getChannelId();
+        // windows without samples of this channel are skipped, so the iterator only runs dry at the end
+        while (hasWindow(channel.m_next_window))
+        {
+            const auto index = channel.m_next_window;
+            if (isDropped(index))
+            {
+                // reading the window again would transfer the data of all channels for this one
+                startFallback(channel, m_window_bounds[index]);
+                channel.m_fallback->updateStreamIterator(&iterator);
+                break;
+            }
+
+            Window* window = getWindow(index);
+            if (!window)
+            {
+                break;
+            }
+            ++channel.m_next_window;
+
+            if (window->m_stream_reader.hasBlocks(channel_id))
+            {
+                channel.m_previous_window = channel.m_current_window;
+                channel.m_current_window = index;
+
+                if (window->m_stream != channel.m_stream)
+                {
+                    window->m_stream_reader.setStreamDescriptor(*channel.m_stream);
+                    window->m_stream = channel.m_stream;
+                }
+                window->m_stream_reader.updateStreamIterator(channel_id, iterator, odk::Interval<std::uint64_t>(0, std::numeric_limits<std::uint64_t>::max()));
+                break;
+            }
+        }
+
+        releaseWindows();
+    }
+
+    bool MultiChannelDataRequester::hasWindow(std::size_t index) const noexcept
+    {
+        return index + 1 < m_window_bounds.size() || m_window_bounds.back() != m_end_position;
+    }
+
+    bool MultiChannelDataRequester::isDropped(std::size_t index) const noexcept
+    {
+        return index + 1 < m_window_bounds.size() && m_windows.find(index) == m_windows.end();
+    }
+
+    MultiChannelDataRequester::Window* MultiChannelDataRequester::getWindow(std::size_t index)
+    {
+        auto existing = m_windows.find(index);
+        if (existing != m_windows.end())
+        {
+            return existing->second.get();
+        }
+
+        // dropped windows are not read again (@see startFallback), so only the next window is requested
+        ODK_ASSERT_EQUAL(index + 1, m_window_bounds.size());
+        WindowData data = m_prefetch.valid() ? m_prefetch.get() : readWindow(m_window_bounds.back(), m_window_sizer.getInterval());
+        if (!data.m_complete)
+        {
+            return nullptr;
+        }
+        if (data.m_read_bytes > 0)
+        {
+            m_window_sizer.update(data.m_read_interval, data.m_read_bytes, data.m_read_latency);
+        }
+        m_window_bounds.push_back(data.m_end_position);
+
+        std::unique_ptr<Window> window;
+        if (m_spare_windows.empty())
+        {
+            window = std::make_unique<Window>();
+            window->m_stream = nullptr;
+        }
+        else
+        {
+            window = std::move(m_spare_windows.back());
+            m_spare_windows.pop_back();
+        }
+
+        window->m_data_block_list = std::move(data.m_data_block_list);
+        if (window->m_data_block_list)
+        {
+            window->m_stream_reader.addDataBlocks(window->m_data_block_list.get());
+        }
+        for (const auto& valid_region : data.m_data_regions)
+        {
+            window->m_stream_reader.addDataRegion(valid_region);
+        }
+
+        auto result = window.get();
+        m_windows.emplace(index, std::move(window));
+
+        startPrefetch();
+        return result;
+    }
+
+    void MultiChannelDataRequester::startFallback(ChannelUpdater& channel, double position)
+    {
+        channel.m_fallback = std::make_unique<DataRequester>(m_host, channel.m_channel, m_user_reduced);
+        channel.m_fallback->setPrefetchEnabled(m_prefetch_enabled);
+        channel.m_fallback->resetPosition(position, m_end_position);
+
+        // the chunks of the current window stay valid until the next update
+        channel.m_previous_window = channel.m_current_window;
+        channel.m_current_window = NO_WINDOW;
+    }
+
+    void MultiChannelDataRequester::releaseWindows()
+    {
+        auto is_used = [this](std::size_t index)
+        {
+            return std::any_of(m_channels.begin(), m_channels.end(),
+                [index](const auto& channel)
+                {
+                    return channel.second->m_current_window == index || channel.second->m_previous_window == index;
+                });
+        };
+        auto is_pending = [this](std::size_t index)
+        {
+            return std::any_of(m_channels.begin(), m_channels.end(),
+                [index](const auto& channel)
+                {
+                    return channel.second->m_stream && !channel.second->m_fallback && channel.second->m_next_window <= index;
+                });
+        };
+
+        auto release = [this](std::map<std::size_t, std::unique_ptr<Window>>::iterator it)
+        {
+            auto window = std::move(it->second);
+            window->m_stream_reader.clearBlocks();
+            window->m_data_block_list.reset();
+            if (m_spare_windows.size() < MAX_BUFFERED_WINDOWS)
+            {
+                m_spare_windows.push_back(std::move(window));
+            }
+            return m_windows.erase(it);
+        };
+
+        for (auto it = m_windows.begin(); it != m_windows.end();)
+        {
+            if (!is_used(it->first) && !is_pending(it->first))
+            {
+                it = release(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // keep the windows lagging iterators will reach next, drop the ones furthest ahead
+        while (m_windows.size() > MAX_BUFFERED_WINDOWS)
+        {
+            auto it = m_windows.end();
+            do
+            {
+                --it;
+            } while (it != m_windows.begin() && is_used(it->first));
+
+            if (is_used(it->first))
+            {
+                break;
+            }
+            release(it);
+        }
+    }
+
+    void MultiChannelDataRequester::clearWindows()
+    {
+        while (!m_windows.empty())
+        {
+            auto window = std::move(m_windows.begin()->second);
+            m_windows.erase(m_windows.begin());
+            window->m_stream_reader.clearBlocks();
+            window->m_data_block_list.reset();
+            if (m_spare_windows.size() < MAX_BUFFERED_WINDOWS)
+            {
+                m_spare_windows.push_back(std::move(window));
+            }
+        }
+        m_window_bounds.clear();
+    }
+
+    MultiChannelDataRequester::WindowData MultiChannelDataRequester::readWindow(double position, double interval) const
+    {
+        WindowData window;
+        window.m_end_position = position;
+
+        do
+        {
+            double next_position = std::min(position + interval, m_end_position);
+
             auto xml_msg = m_host->createValue<odk::IfXMLValue>();
-            if (xml_msg)
+            if (!xml_msg)
+            {
+                window.m_complete = false;
+                return window;
+            }
+            PluginDataRequest req(m_dataset_descriptor.m_id, PluginDataRequest::DataWindow(position, next_position));
+            if (!m_region_cache.covers(position, next_position))
+            {
+                req.m_include_data_regions = true;
+            }
+            xml_msg->set(req.generate().c_str());
+
+            const odk::IfValue* response = nullptr;
+            const auto request_start = std::chrono::steady_clock::now();
+            ++m_read_count;
+            if (0 != m_host->messageSync(odk::host_msg::DATA_READ, 0, xml_msg.get(), &response))
             {
-                PluginDataRegionsRequest req(m_dataset_descriptor.m_id);
-                req.m_data_window = PluginDataRegionsRequest::DataWindow(start, end);
-                xml_msg->set(req.generate().c_str());
+                window.m_complete = false;
+                return window;
             }
 
-            const odk::IfValue* data_regions_result = nullptr;
-            m_host->messageSync(odk::host_msg::DATA_REGIONS_READ, 0, xml_msg.get(), &data_regions_result);
+            window.m_data_block_list = odk::ptr(odk::value_cast<odk::IfDataBlockList>(response));
+            window.m_read_latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - request_start).count();
+            window.m_read_interval = next_position - position;
+            window.m_read_bytes = getDataSize(window.m_data_block_list.get());
+
+            auto data_regions = m_region_cache.covers(position, next_position)
+                ? m_region_cache.getRegions(position, next_position)
+                : getBlockListDataRegions(m_host, m_dataset_descriptor.m_id, window.m_data_block_list.get(), position, next_position);
 
-            const odk::IfXMLValue* data_regions_result_xml = odk::value_cast<odk::IfXMLValue>(data_regions_result);
-            if (data_regions_result)
+            if (data_regions.empty() && m_region_cache.covers(position, m_end_position))
             {
-                if (data_regions_result_xml)
+                const auto next_region_start = m_region_cache.getNextRegionStart(position);
+                next_position = next_region_start ? std::min(m_end_position, *next_region_start) : m_end_position;
+            }
+            else if (data_regions.empty())
+            {
+                // continue at the earliest region of any channel
+                next_position = m_end_position;
+                for (const auto& region : requestDataRegions(m_host, m_dataset_descriptor.m_id, position, m_end_position))
                 {
-                    data_regions = std::make_shared<DataRegions>();
-                    data_regions->parse(data_regions_result_xml->asStringView());
+                    auto channel = m_channels.find(region.m_channel_id);
+                    if (channel == m_channels.end())
+                    {
+                        continue;
+                    }
+                    double region_start = region.m_region.m_begin / channel->second->m_channel->getTimeBase().m_frequency;
+                    if (m_user_reduced)
+                    {
+                        region_start *= channel->second->m_ratio;
+                    }
+                    if (region_start >= position)
+                    {
+                        next_position = std::min(next_position, region_start);
+                    }
                 }
-                data_regions_result->release();
             }
+            else
+            {
+                window.m_data_regions.insert(window.m_data_regions.end(), data_regions.begin(), data_regions.end());
+            }
+
+            position = next_position;
+            window.m_end_position = position;
+        } while (position != m_end_position
+            && (!window.m_data_block_list || window.m_data_block_list->getBlockCount() == 0));
+
+        return window;
+    }
+
+    void MultiChannelDataRequester::startPrefetch()
+    {
+        if (m_prefetch_enabled && !m_prefetch.valid() && m_window_bounds.back() != m_end_position)
+        {
+            m_prefetch = std::async(std::launch::async, &MultiChannelDataRequester::readWindow, this,
+                m_window_bounds.back(), m_window_sizer.getInterval());
         }
-        if (data_regions)
+    }
+
+    void MultiChannelDataRequester::cancelPrefetch()
+    {
+        if (m_prefetch.valid())
         {
-            return data_regions->m_data_regions;
+            m_prefetch.wait();
+            m_prefetch = {};
         }
-        return {};
     }
 }
 }
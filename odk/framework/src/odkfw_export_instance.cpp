@@ -78,6 +78,9 @@ namespace framework
                 m_context.m_properties.m_custom_properties.getBool("EXPORT_STATISTICS");
         }
 
+        const auto& first_interval = start_telegram.m_properties.m_export_intervals.front();
+        std::vector<std::shared_ptr<InputChannel>> shared_channels;
+
         for(const auto& channel_id : start_telegram.m_properties.m_channels)
         {
             auto new_input_channel = std::make_shared<InputChannel>(m_host, channel_id);
@@ -85,36 +88,35 @@ namespace framework
             new_input_channel->updateTimeBase();
             m_context.m_channels.insert_or_assign(channel_id, new_input_channel);
 
-            auto& first_interval = start_telegram.m_properties.m_export_intervals.front();
+            // if enabled, all channels except single value channels share one data set
+            if (m_shared_data_set
+                && new_input_channel->getDataFormat().m_sample_occurrence != odk::ChannelDataformat::SampleOccurrence::SINGLE_VALUE)
+            {
+                shared_channels.push_back(new_input_channel);
+                continue;
+            }
 
             if (export_waveform)
             {
-                auto raw_requester = std::make_unique<DataRequester>(getHost(), new_input_channel);
-                try
-                {
-                    m_context.m_channel_iterators[channel_id] =
-                        raw_requester->getIterator(first_interval.m_begin, first_interval.m_end);
-                }
-                catch (const std::exception&)
-                {
-                    // no valid data
-                }
-                m_data_requester.push_back(std::move(raw_requester));
+                addChannelRequester(channel_id, new_input_channel, false, first_interval.m_begin, first_interval.m_end);
             }
 
             if (export_statistic)
             {
-                auto reduced_requester = std::make_unique<DataRequester>(getHost(), new_input_channel, true);
-                try
-                {
-                    m_context.m_reduced_channel_iterators[channel_id] =
-                        reduced_requester->getIterator(first_interval.m_begin, first_interval.m_end);
-                }
-                catch (const std::exception&)
-                {
-                    // no valid data
-                }
-                m_reduced_requester.push_back(std::move(reduced_requester));
+                addChannelRequester(channel_id, new_input_channel, true, first_interval.m_begin, first_interval.m_end);
+            }
+        }
+
+        if (!shared_channels.empty())
+        {
+            if (export_waveform)
+            {
+                addSharedRequester(shared_channels, false, first_interval.m_begin, first_interval.m_end);
+            }
+
+            if (export_statistic)
+            {
+                addSharedRequester(shared_channels, true, first_interval.m_begin, first_interval.m_end);
             }
         }
 
@@ -143,6 +145,55 @@ namespace framework
         m_worker_thread = std::thread(exportFunction);
     }
 
+    void ExportInstance::setSharedDataSetEnabled(bool enabled) noexcept
+    {
+        m_shared_data_set = enabled;
+    }
+
+    void ExportInstance::addChannelRequester(uint64_t channel_id, const std::shared_ptr<InputChannel>& channel, bool user_reduced, double start, double end)
+    {
+        auto requester = std::make_unique<DataRequester>(getHost(), channel, user_reduced);
+        requester->setPrefetchEnabled(true);
+        try
+        {
+            auto& iterators = user_reduced ? m_context.m_reduced_channel_iterators : m_context.m_channel_iterators;
+            iterators[channel_id] = requester->getIterator(start, end);
+        }
+        catch (const std::exception&)
+        {
+            // no valid data
+        }
+        (user_reduced ? m_reduced_requester : m_data_requester).push_back(std::move(requester));
+    }
+
+    void ExportInstance::addSharedRequester(const std::vector<std::shared_ptr<InputChannel>>& channels, bool user_reduced, double start, double end)
+    {
+        auto& requester = user_reduced ? m_reduced_multi_channel_requester : m_multi_channel_requester;
+        auto& iterators = user_reduced ? m_context.m_reduced_channel_iterators : m_context.m_channel_iterators;
+
+        requester = std::make_unique<MultiChannelDataRequester>(getHost(), channels, user_reduced);
+        requester->setPrefetchEnabled(true);
+        try
+        {
+            for (auto& iterator : requester->getIterators(start, end))
+            {
+                iterators[iterator.first] = std::move(iterator.second);
+            }
+        }
+        catch (const std::exception&)
+        {
+            // the shared data set failed as a whole, the channels are requested individually below
+        }
+
+        for (const auto& channel : channels)
+        {
+            if (iterators.count(channel->getChannelId()) == 0)
+            {
+                addChannelRequester(channel->getChannelId(), channel, user_reduced, start, end);
+            }
+        }
+    }
+
     void ExportInstance::setCanceled()
     {
         m_canceled.store(true, std::memory_order_release);
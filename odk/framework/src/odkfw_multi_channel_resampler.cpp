@@ -0,0 +1,112 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_multi_channel_resampler.h"
+#include "odkapi_error_codes.h"
+
+#include <algorithm>
+
+using odk::framework::MultiChannelResampler;
+
+namespace
+{
+    /**
+     * Linear Interpolation function
+     */
+    inline double lerp(double a, double b, double t)
+    {
+        return a + (b - a) * t;
+    }
+}
+
+MultiChannelResampler::MultiChannelResampler(std::size_t channel_count, double nominal_rate, Layout layout)
+    : m_nominal_sample_rate(nominal_rate)
+    , m_layout(layout)
+    , m_timebase()
+    , m_actual_scnt(0)
+    , m_last_samples(channel_count, 0.0)
+{
+}
+
+void MultiChannelResampler::setNominalSampleRate(double rate)
+{
+    m_nominal_sample_rate = rate;
+}
+
+void MultiChannelResampler::reset()
+{
+    m_timebase.reset();
+    m_actual_scnt = 0;
+    std::fill(m_last_samples.begin(), m_last_samples.end(), 0.0);
+    m_output_buffer.clear();
+}
+
+std::uint64_t MultiChannelResampler::addSamples(odk::IfHost* host, const std::uint32_t* local_channel_ids, double last_sample_timestamp, const double* data, std::size_t num_samples)
+{
+    const auto channel_count = m_last_samples.size();
+    if (num_samples == 0 || channel_count == 0)
+    {
+        return odk::error_codes::OK;
+    }
+
+    // sample i of channel c is data[c * channel_offset + i * sample_stride]
+    const std::size_t sample_stride = m_layout == Layout::INTERLEAVED ? channel_count : 1;
+    const std::size_t channel_offset = m_layout == Layout::INTERLEAVED ? 1 : num_samples;
+
+    // only the last sample of the previous block is kept, at position -1 relative to the first sample
+    const bool has_previous_samples = m_timebase.getSampleCount() > 0;
+    m_timebase.addBlock(last_sample_timestamp, num_samples);
+    const auto positions = m_timebase.getOutputPositions(m_actual_scnt, m_nominal_sample_rate);
+
+    // input index and weight of every output sample, computed once for all channels
+    // output samples before the first input sample interpolate from the previous sample of the channel
+    std::size_t num_before_block = 0;
+    m_indices.resize(positions.m_count);
+    m_weights.resize(positions.m_count);
+    for (std::size_t n = 0; n < positions.m_count; ++n)
+    {
+        const double pos = positions.m_first + static_cast<double>(n) * positions.m_step;
+        if (pos < 0.0)
+        {
+            m_indices[n] = 0;
+            m_weights[n] = pos + 1.0;
+            ++num_before_block;
+        }
+        else
+        {
+            const auto idx = static_cast<std::size_t>(pos);
+            m_indices[n] = idx * sample_stride;
+            m_weights[n] = pos - static_cast<double>(idx);
+        }
+    }
+
+    std::uint64_t result = odk::error_codes::OK;
+    m_output_buffer.resize(positions.m_count);
+    for (std::size_t channel = 0; channel < channel_count; ++channel)
+    {
+        const double* input = data + channel * channel_offset;
+        if (positions.m_count > 0)
+        {
+            double* output = m_output_buffer.data();
+            const double previous_sample = has_previous_samples ? m_last_samples[channel] : input[0];
+            for (std::size_t n = 0; n < num_before_block; ++n)
+            {
+                output[n] = lerp(previous_sample, input[0], m_weights[n]);
+            }
+            for (std::size_t n = num_before_block; n < positions.m_count; ++n)
+            {
+                const double* samples = input + m_indices[n];
+                output[n] = lerp(samples[0], samples[sample_stride], m_weights[n]);
+            }
+
+            const auto channel_result = m_output_buffer.send(host, local_channel_ids[channel], m_actual_scnt);
+            if (result == odk::error_codes::OK)
+            {
+                result = channel_result;
+            }
+        }
+        m_last_samples[channel] = input[(num_samples - 1) * sample_stride];
+    }
+    m_actual_scnt += positions.m_count;
+
+    return result;
+}
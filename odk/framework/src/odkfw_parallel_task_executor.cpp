@@ -0,0 +1,263 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_parallel_task_executor.h"
+#include "odkapi_message_ids.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace odk
+{
+namespace framework
+{
+    /**
+     * Host calls of the jobs, executed by the thread waiting in run()
+     */
+    class ParallelTaskExecutor::CallQueue
+    {
+    public:
+        explicit CallQueue(std::size_t job_count)
+            : m_running_jobs(job_count)
+        {
+        }
+
+        /**
+         * Queues the call and returns immediately
+         */
+        void post(std::function<void()> function)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_calls.push_back({std::move(function), nullptr, nullptr});
+            }
+            m_changed.notify_all();
+        }
+
+        /**
+         * Queues the call and waits until it has been executed
+         * an exception thrown by the call is rethrown on the calling thread
+         */
+        void call(std::function<void()> function)
+        {
+            bool done = false;
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_calls.push_back({std::move(function), &done, &error});
+                m_changed.notify_all();
+                m_changed.wait(lock, [&done] { return done; });
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        void jobFinished()
+        {
+            // notify under the lock, the queue is destroyed as soon as serve() saw the last job finish
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_running_jobs;
+            m_changed.notify_all();
+        }
+
+        /**
+         * Executes queued calls until all jobs are finished
+         * the first exception thrown by a posted call is rethrown afterwards, nobody waits for those calls
+         */
+        void serve()
+        {
+            std::exception_ptr posted_error;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_changed.wait(lock, [this] { return !m_calls.empty() || m_running_jobs == 0; });
+                if (m_calls.empty())
+                {
+                    break;
+                }
+
+                Call call = std::move(m_calls.front());
+                m_calls.pop_front();
+
+                lock.unlock();
+                std::exception_ptr error;
+                try
+                {
+                    call.m_function();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                lock.lock();
+
+                if (call.m_done)
+                {
+                    *call.m_error = error;
+                    *call.m_done = true;
+                    m_changed.notify_all();
+                }
+                else if (error && !posted_error)
+                {
+                    posted_error = error;
+                }
+            }
+            lock.unlock();
+
+            if (posted_error)
+            {
+                std::rethrow_exception(posted_error);
+            }
+        }
+
+    private:
+        struct Call
+        {
+            std::function<void()> m_function;
+            bool* m_done;   ///< set when the call has been executed, nullptr for posted calls
+            std::exception_ptr* m_error;    ///< receives the exception thrown by the call, nullptr for posted calls
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        std::deque<Call> m_calls;
+        std::size_t m_running_jobs;
+    };
+
+    /**
+     * Host handed to the jobs, forwards every call to the CallQueue
+     */
+    class ParallelTaskExecutor::HostProxy : public odk::IfHost
+    {
+    public:
+        HostProxy(odk::IfHost* host, CallQueue& queue)
+            : m_host(host)
+            , m_queue(queue)
+        {
+        }
+
+        odk::IfValue* PLUGIN_API createValue(odk::IfValue::Type type) const override
+        {
+            odk::IfValue* value = nullptr;
+            m_queue.call([&] { value = m_host->createValue(type); });
+            return value;
+        }
+
+        std::uint64_t PLUGIN_API messageSync(odk::MessageId msg_id, std::uint64_t key, const odk::IfValue* param, const odk::IfValue** ret) override
+        {
+            std::uint64_t result = 0;
+            m_queue.call([&] { result = m_host->messageSync(msg_id, key, param, ret); });
+            return result;
+        }
+
+        std::uint64_t PLUGIN_API messageSyncData(odk::MessageId msg_id, std::uint64_t key, const void* param, std::uint64_t param_size, const odk::IfValue** ret) override
+        {
+            if (!ret && (msg_id == odk::host_msg::ADD_SAMPLE || msg_id == odk::host_msg::ADD_CONTIGUOUS_SAMPLES))
+            {
+                // samples are only written, the job does not have to wait for the host
+                const auto* bytes = static_cast<const std::uint8_t*>(param);
+                m_queue.post([host = m_host, msg_id, key, data = std::vector<std::uint8_t>(bytes, bytes + param_size)]
+                    {
+                        host->messageSyncData(msg_id, key, data.data(), data.size(), nullptr);
+                    });
+                return 0;
+            }
+
+            std::uint64_t result = 0;
+            m_queue.call([&] { result = m_host->messageSyncData(msg_id, key, param, param_size, ret); });
+            return result;
+        }
+
+        std::uint64_t PLUGIN_API messageAsync(odk::MessageId msg_id, std::uint64_t key, const odk::IfValue* param) override
+        {
+            std::uint64_t result = 0;
+            m_queue.call([&] { result = m_host->messageAsync(msg_id, key, param); });
+            return result;
+        }
+
+        const odk::IfValue* PLUGIN_API query(const char* context, const char* item, const odk::IfValue* param) override
+        {
+            const odk::IfValue* result = nullptr;
+            m_queue.call([&] { result = m_host->query(context, item, param); });
+            return result;
+        }
+
+        const odk::IfValue* PLUGIN_API queryXML(const char* context, const char* item, const char* xml, std::uint64_t xml_size) override
+        {
+            const odk::IfValue* result = nullptr;
+            m_queue.call([&] { result = m_host->queryXML(context, item, xml, xml_size); });
+            return result;
+        }
+
+    private:
+        odk::IfHost* m_host;
+        CallQueue& m_queue;
+    };
+
+    ParallelTaskExecutor::ParallelTaskExecutor(std::size_t thread_count)
+        : m_pool(thread_count)
+    {
+    }
+
+    ParallelTaskExecutor::~ParallelTaskExecutor() = default;
+
+    std::size_t ParallelTaskExecutor::getThreadCount() const noexcept
+    {
+        return m_pool.getThreadCount();
+    }
+
+    WorkStealingThreadPool& ParallelTaskExecutor::getThreadPool() noexcept
+    {
+        return m_pool;
+    }
+
+    void ParallelTaskExecutor::run(odk::IfHost* host, const std::vector<Job>& jobs)
+    {
+        if (jobs.empty())
+        {
+            return;
+        }
+
+        if (jobs.size() == 1)
+        {
+            jobs.front()(host);
+            return;
+        }
+
+        CallQueue queue(jobs.size());
+        HostProxy proxy(host, queue);
+        std::vector<std::exception_ptr> errors(jobs.size());
+
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            m_pool.submit([&, i]
+                {
+                    try
+                    {
+                        jobs[i](&proxy);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                    queue.jobFinished();
+                });
+        }
+
+        queue.serve();
+
+        for (const auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+}
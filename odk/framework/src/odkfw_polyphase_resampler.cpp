@@ -0,0 +1,186 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_polyphase_resampler.h"
+#include "odkapi_error_codes.h"
+#include "odkapi_message_ids.h"
+#include "odkbase_if_host.h"
+
+#include <algorithm>
+#include <cmath>
+
+using odk::framework::PolyphaseResampler;
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+
+    /**
+     * Blackman window over [-half_width, half_width]
+     */
+    inline double blackman(double x, double half_width)
+    {
+        if (std::abs(x) >= half_width)
+        {
+            return 0.0;
+        }
+        const double phase = PI * x / half_width;
+        return 0.42 + 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+    }
+
+    inline double sinc(double x)
+    {
+        if (x == 0.0)
+        {
+            return 1.0;
+        }
+        return std::sin(PI * x) / (PI * x);
+    }
+
+    /**
+     * Dot product of two arrays, count has to be a multiple of 4
+     * Independent partial sums allow the compiler to vectorize the loop
+     */
+    inline double dot(const double* samples, const double* coefficients, std::size_t count)
+    {
+        double sum0 = 0.0;
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+        double sum3 = 0.0;
+        for (std::size_t n = 0; n < count; n += 4)
+        {
+            sum0 += samples[n] * coefficients[n];
+            sum1 += samples[n + 1] * coefficients[n + 1];
+            sum2 += samples[n + 2] * coefficients[n + 2];
+            sum3 += samples[n + 3] * coefficients[n + 3];
+        }
+        return (sum0 + sum1) + (sum2 + sum3);
+    }
+}
+
+PolyphaseResampler::PolyphaseResampler(double nominal_rate, std::size_t tap_count, std::size_t phase_count, double cutoff)
+    : m_nominal_sample_rate(nominal_rate)
+    , m_tap_count(std::max<std::size_t>((tap_count + 3) / 4 * 4, 4))
+    , m_phase_count(std::max<std::size_t>(phase_count, 1))
+    , m_timebase()
+    , m_actual_scnt(0)
+    , m_history_start(0)
+{
+    computeCoefficients(cutoff);
+}
+
+void PolyphaseResampler::setNominalSampleRate(double rate)
+{
+    m_nominal_sample_rate = rate;
+}
+
+void PolyphaseResampler::reset()
+{
+    m_timebase.reset();
+    m_actual_scnt = 0;
+    m_history.clear();
+    m_history_start = 0;
+    m_output_buffer.clear();
+}
+
+void PolyphaseResampler::computeCoefficients(double cutoff)
+{
+    // row q interpolates at fractional position q / phase_count after input sample idx,
+    // coefficient j is applied to input sample idx - tap_count / 2 + 1 + j
+    const double half_width = static_cast<double>(m_tap_count / 2);
+    m_coefficients.resize((m_phase_count + 1) * m_tap_count);
+    for (std::size_t phase = 0; phase <= m_phase_count; ++phase)
+    {
+        double* row = &m_coefficients[phase * m_tap_count];
+        const double fraction = static_cast<double>(phase) / static_cast<double>(m_phase_count);
+
+        double sum = 0.0;
+        for (std::size_t tap = 0; tap < m_tap_count; ++tap)
+        {
+            const double distance = fraction + half_width - 1.0 - static_cast<double>(tap);
+            row[tap] = 2.0 * cutoff * sinc(2.0 * cutoff * distance) * blackman(distance, half_width);
+            sum += row[tap];
+        }
+
+        // unity gain for constant signals
+        for (std::size_t tap = 0; tap < m_tap_count; ++tap)
+        {
+            row[tap] /= sum;
+        }
+    }
+}
+
+std::uint64_t PolyphaseResampler::addSamples(odk::IfHost* host, std::uint32_t local_channel_id, double last_sample_timestamp, const double* data, std::size_t num_samples)
+{
+    if (num_samples == 0)
+    {
+        return odk::error_codes::OK;
+    }
+
+    const auto half_taps = static_cast<std::int64_t>(m_tap_count / 2);
+    if (m_timebase.getSampleCount() == 0)
+    {
+        // the first sample is repeated before the start, so the first output samples have a complete filter history
+        m_history.assign(static_cast<std::size_t>(half_taps), data[0]);
+        m_history_start = -half_taps;
+    }
+
+    m_timebase.addBlock(last_sample_timestamp, num_samples);
+    m_history.insert(m_history.end(), data, data + num_samples);
+
+    if (!(m_timebase.getSampleDuration() > 0.0))
+    {
+        // no progress in time, the samples are resampled with the next block
+        return odk::error_codes::OK;
+    }
+
+    // output sample n at input position p requires the input samples up to floor(p) + tap_count / 2
+    const auto available_end = static_cast<std::int64_t>(m_timebase.getSampleCount());
+    const auto first_position = static_cast<double>(m_history_start + half_taps - 1);
+    auto getOutputPosition = [this, first_position](std::size_t n)
+    {
+        // positions before the kept history can only occur if the estimated sample duration increased
+        return std::max(m_timebase.getPosition(n / m_nominal_sample_rate), first_position);
+    };
+
+    // Prepare the output buffer which has a uint64 timestamp followed by at most all samples up to the last timestamp
+    const double max_num = std::ceil(last_sample_timestamp * m_nominal_sample_rate) - static_cast<double>(m_actual_scnt);
+    const std::size_t num = max_num > 0.0 ? static_cast<std::size_t>(max_num) : 0;
+    m_output_buffer.resize(1 + num);
+
+    static_assert(sizeof(std::uint64_t) == sizeof(double), "The following code only works when double and uint64 have the same size");
+    *reinterpret_cast<std::uint64_t*>(m_output_buffer.data()) = m_actual_scnt;
+
+    double* output = m_output_buffer.data() + 1;
+    std::size_t num_written = 0;
+    for (; num_written < num; ++num_written)
+    {
+        const double position = getOutputPosition(m_actual_scnt + num_written);
+        const double index = std::floor(position);
+        const auto phase = static_cast<std::size_t>((position - index) * static_cast<double>(m_phase_count) + 0.5);
+
+        const auto idx = static_cast<std::int64_t>(index);
+        if (idx + half_taps >= available_end)
+        {
+            break;
+        }
+
+        const double* samples = m_history.data() + (idx - half_taps + 1 - m_history_start);
+        output[num_written] = dot(samples, m_coefficients.data() + phase * m_tap_count, m_tap_count);
+    }
+
+    std::uint64_t result = odk::error_codes::OK;
+    if (num_written > 0)
+    {
+        m_output_buffer.resize(1 + num_written);
+        result = host->messageSyncData(odk::host_msg::ADD_CONTIGUOUS_SAMPLES, local_channel_id, m_output_buffer.data(), m_output_buffer.size() * sizeof(double), nullptr);
+        m_actual_scnt += num_written;
+    }
+
+    // drop the history that is not needed by the next output sample
+    const auto keep_from = static_cast<std::int64_t>(std::floor(getOutputPosition(m_actual_scnt))) - half_taps + 1;
+    const auto drop = static_cast<std::size_t>(std::clamp<std::int64_t>(keep_from - m_history_start, 0, static_cast<std::int64_t>(m_history.size())));
+    m_history.erase(m_history.begin(), m_history.begin() + drop);
+    m_history_start += static_cast<std::int64_t>(drop);
+
+    return result;
+}
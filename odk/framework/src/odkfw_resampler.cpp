@@ -4,12 +4,12 @@
 #include "odkapi_error_codes.h"
 #include "odkapi_message_ids.h"
 #include "odkbase_if_host.h"
-#include "odkuni_assert.h"
 
+#include <algorithm>
 #include <cmath>
-#include <limits>
 
 using odk::framework::Resampler;
+using odk::framework::ResamplerTimebase;
 
 namespace
 {
@@ -21,61 +21,137 @@ namespace
         return a + (b - a) * t;
     }
 
-    class InputVectorLabels
+    /**
+     * Writes count linearly interpolated samples at the input positions first_position + n * position_step
+     * Position 0 is input[0], positions in [-1, 0) interpolate between previous_sample and input[0].
+     * All positions have to be in [-1, num_input - 1), so no bounds are checked per sample.
+     */
+    void interp(double* output, std::size_t count, double first_position, double position_step, double previous_sample, const double* input)
     {
-    public:
-        InputVectorLabels(double start, double end, std::size_t size)
-            : m_start(start)
-            //, m_end(end)
-            //, m_size(static_cast<double>(size))
-            , m_scale(static_cast<double>(size) / (end - start)) // precompute the index scaling
+        std::size_t n = 0;
+        for (; n < count; ++n)
         {
+            const double pos = first_position + static_cast<double>(n) * position_step;
+            if (pos >= 0.0)
+            {
+                break;
+            }
+            output[n] = lerp(previous_sample, input[0], pos + 1.0);
         }
 
-        inline double indexOfTime(double time) const
+        // no branches or calls in the main loop, truncation equals floor for positive positions
+        for (; n < count; ++n)
         {
-            //return m_size * (time - m_start) / (m_end - m_start);
-            return m_scale * (time - m_start);
+            const double pos = first_position + static_cast<double>(n) * position_step;
+            const auto idx = static_cast<std::size_t>(pos);
+            output[n] = lerp(input[idx], input[idx + 1], pos - static_cast<double>(idx));
         }
+    }
+}
 
-    private:
-        double m_start;
-        //double m_end;
-        //double m_size;
-        double m_scale;
-    };
+ResamplerTimebase::ResamplerTimebase()
+    : m_last_timestamp(0)
+    , m_model_timestamp(0)
+    , m_sample_duration(0)
+    , m_tracked_sample_duration(0)
+    , m_timestamp_error(0)
+    , m_tracking_gain(1)
+    , m_sample_count(0)
+    , m_block_size(0)
+    , m_block_count(0)
+{
+}
 
-    /**
-     * computes linearly interpolated output samples and pushes them to the vector
-     */
-    std::size_t interp(std::vector<double>& output, std::uint64_t x_start, double x_samplerate, std::size_t num, const InputVectorLabels& fp_time, const std::vector<double>& fp)
+void ResamplerTimebase::reset()
+{
+    m_last_timestamp = 0;
+    m_model_timestamp = 0;
+    m_sample_duration = 0;
+    m_tracked_sample_duration = 0;
+    m_timestamp_error = 0;
+    m_sample_count = 0;
+    m_block_size = 0;
+    m_block_count = 0;
+}
+
+void ResamplerTimebase::setDriftTracking(double gain)
+{
+    m_tracking_gain = gain > 0.0 ? std::min(gain, 1.0) : 1.0;
+}
+
+void ResamplerTimebase::addBlock(double last_sample_timestamp, std::size_t num_samples)
+{
+    if (num_samples == 0)
     {
-        for (std::size_t n = 0; n < num; ++n)
-        {
-            double val = (x_start + n) / x_samplerate;
-            double pos = fp_time.indexOfTime(val);
+        return;
+    }
 
-            const int idx = static_cast<int>(std::floor(pos));
-            const double t = pos - static_cast<double>(idx);
+    const double block_length = static_cast<double>(num_samples);
+    const double predicted_timestamp = m_model_timestamp + block_length * m_tracked_sample_duration;
+    const double error = last_sample_timestamp - predicted_timestamp;
 
-            ODK_ASSERT_GTE(idx, 0);
-            if (static_cast<std::size_t>(idx) + 1 >= fp.size())
-            {
-                // element fp[idx + 1] is inaccessible, early return
-                return n;
-            }
+    // the first block only gives a duration relative to time 0, the loop starts from the second one
+    // an error larger than the predicted block (gap, clock step) restarts it
+    double model_timestamp = last_sample_timestamp;
+    if (m_tracking_gain >= 1.0 || m_block_count < 2 || std::abs(error) >= block_length * m_tracked_sample_duration)
+    {
+        m_tracked_sample_duration = (last_sample_timestamp - m_last_timestamp) / num_samples;
+        m_timestamp_error = 0;
+    }
+    else
+    {
+        // alpha-beta filter, beta = alpha^2 / (2 - alpha) (Benedict-Bordner) balances settling time and noise
+        const double beta = m_tracking_gain * m_tracking_gain / (2.0 - m_tracking_gain);
+        model_timestamp = predicted_timestamp + m_tracking_gain * error;
+        m_tracked_sample_duration += beta * error / block_length;
+        m_timestamp_error = error;
+    }
+
+    // without tracking the model timestamp equals the last timestamp and both durations are the same
+    m_sample_duration = (model_timestamp - m_model_timestamp) / num_samples;
+    m_model_timestamp = model_timestamp;
+
+    m_last_timestamp = last_sample_timestamp;
+    m_sample_count += num_samples;
+    m_block_size = num_samples;
+    ++m_block_count;
+}
+
+ResamplerTimebase::OutputPositions ResamplerTimebase::getOutputPositions(std::uint64_t first_tick, double output_rate) const
+{
+    OutputPositions positions;
+    // the model timestamp, so output samples up to the end of the block are positioned before the next one
+    const std::uint64_t last_tick = static_cast<std::uint64_t>(std::floor(m_model_timestamp * output_rate));
+    if (m_block_size == 0 || last_tick <= first_tick || !(m_sample_duration > 0.0))
+    {
+        return positions;
+    }
+    const std::size_t max_count = static_cast<std::size_t>(last_tick - first_tick); // the maximum possible number of sample to compute
 
-            double val_interp = lerp(fp[idx], fp[idx + 1], t);
-            output.push_back(val_interp);
+    // output positions advance by a constant step, positions before the kept sample are clamped
+    const double block_start = static_cast<double>(m_sample_count - m_block_size);
+    const double min_position = m_sample_count > m_block_size ? -1.0 : 0.0;
+    positions.m_step = 1.0 / (output_rate * m_sample_duration);
+    positions.m_first = std::max(getPosition(first_tick / output_rate) - block_start, min_position);
+
+    // an output sample needs the input sample after its position, positions have to be < block size - 1
+    const double end_position = static_cast<double>(m_block_size - 1);
+    if (positions.m_first < end_position)
+    {
+        positions.m_count = static_cast<std::size_t>(std::min(std::ceil((end_position - positions.m_first) / positions.m_step), static_cast<double>(max_count)));
+        while (positions.m_count > 0 && positions.m_first + static_cast<double>(positions.m_count - 1) * positions.m_step >= end_position)
+        {
+            --positions.m_count;
         }
-        return num;
     }
+    return positions;
 }
 
 Resampler::Resampler(double nominal_rate)
     : m_nomianal_sample_rate(nominal_rate)
-    , m_last_timestamp(0)
+    , m_timebase()
     , m_actual_scnt(0)
+    , m_last_sample(0)
 {
 }
 
@@ -86,9 +162,9 @@ void Resampler::setNominalSampleRate(double rate)
 
 void Resampler::reset()
 {
-    m_last_timestamp = 0;
+    m_timebase.reset();
     m_actual_scnt = 0;
-    m_input_buffer.clear();
+    m_last_sample = 0;
     m_output_buffer.clear();
 }
 
@@ -99,45 +175,27 @@ std::uint64_t Resampler::addSamples(odk::IfHost* host, std::uint32_t local_chann
         return odk::error_codes::OK;
     }
 
-    const double last_sample = last_sample_timestamp * m_nomianal_sample_rate;
-    const std::uint64_t last_sample_int = static_cast<std::uint64_t>(std::floor(last_sample));
-
-    double first_sample_timestamp = m_last_timestamp;
-    if (!m_input_buffer.empty())
-    {
-        double estimated_sample_duration = (last_sample_timestamp - m_last_timestamp) / num_samples;
-        first_sample_timestamp -= m_input_buffer.size() * estimated_sample_duration;
-        ODK_ASSERT_GTE(first_sample_timestamp, 0);
-    }
-    m_input_buffer.insert(m_input_buffer.end(), data, data + num_samples);
-
-    InputVectorLabels input_desc(first_sample_timestamp, last_sample_timestamp, m_input_buffer.size());
+    // only the last sample of the previous block is kept, at position -1 relative to data[0]
+    const double previous_sample = m_timebase.getSampleCount() > 0 ? m_last_sample : data[0];
+    m_timebase.addBlock(last_sample_timestamp, num_samples);
+    m_last_sample = data[num_samples - 1];
 
     std::uint64_t result = odk::error_codes::OK;
-    if (last_sample_int > m_actual_scnt)
+    const auto positions = m_timebase.getOutputPositions(m_actual_scnt, m_nomianal_sample_rate);
+    if (positions.m_count > 0)
     {
-        const std::size_t num = static_cast<std::size_t>(last_sample_int) - m_actual_scnt; // the maximum possible number of sample to compute
-
-        // Prepare the output buffer which has a uint64 timestamp followed by up to <num> double values
-        m_output_buffer.resize(1);
+        // Prepare the output buffer which has a uint64 timestamp followed by <m_count> double values
+        m_output_buffer.resize(1 + positions.m_count);
 
         // Store the timestamp of the first output sample
         static_assert(sizeof(std::uint64_t) == sizeof(double), "The following code only works when double and uint64 have the same size");
         *reinterpret_cast<std::uint64_t*>(m_output_buffer.data()) = m_actual_scnt;
 
-        // write up to <num> interpolated samples to m_output_buffer
-        std::size_t num_written = interp(m_output_buffer,
-            m_actual_scnt, m_nomianal_sample_rate, num, // this iterates over real output timestamps in ticks
-            input_desc, // Timestamps of input samples
-            m_input_buffer); // actual input samples
+        interp(m_output_buffer.data() + 1, positions.m_count, positions.m_first, positions.m_step, previous_sample, data);
 
         result = host->messageSyncData(odk::host_msg::ADD_CONTIGUOUS_SAMPLES, local_channel_id, m_output_buffer.data(), m_output_buffer.size() * sizeof(double), nullptr);
-        m_actual_scnt += num_written;
+        m_actual_scnt += positions.m_count;
     }
 
-    // Remember old samples
-    m_last_timestamp = last_sample_timestamp;
-    m_input_buffer.assign(data, data + num_samples);
-
     return result;
 }
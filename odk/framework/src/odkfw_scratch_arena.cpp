@@ -0,0 +1,82 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_scratch_arena.h"
+#include "odkuni_assert.h"
+
+#include <algorithm>
+
+namespace odk
+{
+namespace framework
+{
+    ScratchArena::ScratchArena(std::size_t initial_capacity)
+    {
+        if (initial_capacity > 0)
+        {
+            addBlock(initial_capacity);
+        }
+    }
+
+    void* ScratchArena::allocateBytes(std::size_t size, std::size_t alignment)
+    {
+        ODK_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        // keeps offset, padding and block size computations below from overflowing
+        if (size > std::numeric_limits<std::size_t>::max() / 2 - alignment)
+        {
+            throw std::bad_alloc();
+        }
+
+        if (!m_blocks.empty())
+        {
+            const auto& block = m_blocks.back();
+            const auto address = reinterpret_cast<std::uintptr_t>(block.m_memory.get()) + m_offset;
+            const auto padding = (alignment - address % alignment) % alignment;
+            if (m_offset + padding + size <= block.m_size)
+            {
+                m_offset += padding + size;
+                m_used_size += padding + size;
+                return block.m_memory.get() + m_offset - size;
+            }
+        }
+
+        // the remainder of the current block is left unused until the next reset
+        const std::size_t previous_size = m_blocks.empty() ? 0 : m_blocks.back().m_size;
+        addBlock(std::max({MIN_BLOCK_SIZE, size + alignment, 2 * previous_size}));
+        return allocateBytes(size, alignment);
+    }
+
+    void ScratchArena::reset()
+    {
+        if (m_blocks.size() > 1)
+        {
+            // coalesce, the next call with the same demand fits into a single block
+            const auto capacity = getCapacity();
+            m_blocks.clear();
+            addBlock(capacity);
+        }
+        m_offset = 0;
+        m_used_size = 0;
+    }
+
+    std::size_t ScratchArena::getUsedSize() const noexcept
+    {
+        return m_used_size;
+    }
+
+    std::size_t ScratchArena::getCapacity() const noexcept
+    {
+        std::size_t capacity = 0;
+        for (const auto& block : m_blocks)
+        {
+            capacity += block.m_size;
+        }
+        return capacity;
+    }
+
+    void ScratchArena::addBlock(std::size_t size)
+    {
+        m_blocks.push_back({std::unique_ptr<std::uint8_t[]>(new std::uint8_t[size]), size});
+        m_offset = 0;
+    }
+}
+}
@@ -10,12 +10,15 @@
 #include "odkapi_utils.h"
 #include "odkbase_message_return_value_holder.h"
 #include "odkfw_channels.h"
+#include "odkfw_data_requester.h"
 #include "odkfw_exceptions.h"
 #include "odkfw_properties.h"
 #include "odkfw_property_list_utils.h"
 #include "odkfw_stream_reader.h"
+#include "odkfw_thread_pool.h"
 #include "odkuni_logger.h"
 #include "odkuni_assert.h"
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 
@@ -28,6 +31,58 @@ namespace framework
 
     namespace
     {
+        /**
+         * Makes the host of a running process call available until the call returns
+         */
+        class ProcessingHostScope
+        {
+        public:
+            ProcessingHostScope(odk::IfHost*& processing_host, odk::IfHost* host)
+                : m_processing_host(processing_host)
+            {
+                m_processing_host = host;
+            }
+
+            ~ProcessingHostScope()
+            {
+                m_processing_host = nullptr;
+            }
+
+        private:
+            odk::IfHost*& m_processing_host;
+        };
+
+        /**
+         * Marks all channels of the streams as valid for all times
+         */
+        odk::DataRegions getUnboundedDataRegions(const std::vector<odk::StreamDescriptor>& stream_descriptor)
+        {
+            odk::DataRegions data_regions;
+
+            for (const auto& sd : stream_descriptor)
+            {
+                for (auto& channel : sd.m_channel_descriptors)
+                {
+                    data_regions.m_data_regions.emplace_back(
+                        channel.m_channel_id,
+                        odk::Interval<std::uint64_t>(0, std::numeric_limits<std::uint64_t>::max())
+                    );
+                }
+            }
+            return data_regions;
+        }
+
+        /**
+         * Drops the block ranges of all iterators of the kept processing context
+         * The iterators point into data block lists that only live until their response is released.
+         */
+        void clearChannelIterators(ChannelIteratorTable& iterators) noexcept
+        {
+            for (auto& entry : iterators)
+            {
+                entry.second.clearRanges();
+            }
+        }
 
         void addDefaultProperties(PluginChannelPtr& channel, const std::string& instance_channel_key)
         {
@@ -43,22 +98,10 @@ namespace framework
         const std::vector<odk::StreamDescriptor>& stream_descriptor,
         const odk::IfDataBlockList* block_list)
     {
-        odk::DataRegions data_regions;
-
-        for (const auto& sd : stream_descriptor)
-        {
-            for (auto& channel : sd.m_channel_descriptors)
-            {
-                data_regions.m_data_regions.emplace_back(
-                    channel.m_channel_id,
-                    odk::Interval<std::uint64_t>(0, std::numeric_limits<std::uint64_t>::max())
-                );
-            }
-        }
         return createChannelIterators(stream_descriptor,
                                       block_list,
                                       odk::Interval<double>(0, std::numeric_limits<double>::max()),
-                                      data_regions);
+                                      getUnboundedDataRegions(stream_descriptor));
     }
 
     std::map<uint64_t, odk::framework::StreamIterator> SoftwareChannelInstance::createChannelIterators(
@@ -67,39 +110,37 @@ namespace framework
         const odk::Interval<double>& interval,
         const odk::DataRegions& data_regions)
     {
+        ChannelIteratorTable table;
+        updateChannelIterators(stream_descriptor, block_list, interval, data_regions, table);
 
         std::map<uint64_t, odk::framework::StreamIterator> iterators;
-
-        auto block_list_descriptor_xml = odk::ptr(block_list->getBlockListDescription());
-        BlockListDescriptor list_descriptor;
-        list_descriptor.parse(block_list_descriptor_xml->asStringView());
-
-        odk::framework::StreamReader stream_reader;
-
-        const auto block_count = block_list->getBlockCount();
-        for (int i = 0; i < block_count; ++i)
+        for (auto& entry : table)
         {
-            auto block = odk::ptr(block_list->getBlock(i));
-            auto block_descriptor_xml = odk::ptr(block->getBlockDescription());
-
-            BlockDescriptor block_descriptor;
-            block_descriptor.parse(block_descriptor_xml->asStringView());
-
-            if (!block_descriptor.m_block_channels.empty())
-            {
-                stream_reader.addDataBlock(std::move(block_descriptor), block->data());
-            }
+            iterators.emplace(entry.first, std::move(entry.second));
         }
+        return iterators;
+    }
+
+    void SoftwareChannelInstance::updateChannelIterators(
+        const std::vector<odk::StreamDescriptor>& stream_descriptor,
+        const odk::IfDataBlockList* block_list,
+        const odk::Interval<double>& interval,
+        const odk::DataRegions& data_regions,
+        ChannelIteratorTable& iterators)
+    {
+        // reader is kept across calls to reuse its block table and descriptor cache
+        m_stream_reader.clearBlocks();
+        m_stream_reader.addDataBlocks(block_list);
 
         for(const auto& data_region : data_regions.m_data_regions)
         {
-            stream_reader.addDataRegion(data_region);
+            m_stream_reader.addDataRegion(data_region);
         }
 
         // for every stream, create a reader on the data blocks and read the data
         for (const auto& sd : stream_descriptor)
         {
-            stream_reader.setStreamDescriptor(sd);
+            m_stream_reader.setStreamDescriptor(sd);
 
             for (auto& channel : sd.m_channel_descriptors)
             {
@@ -109,13 +150,24 @@ namespace framework
                     channel_interval.m_begin = convertTimeToTickAtOrAfter(interval.m_begin, getInputChannelProxyChecked(channel.m_channel_id)->getTimeBase().m_frequency);
                     channel_interval.m_end = convertTimeToTickAtOrAfter(interval.m_end, getInputChannelProxyChecked(channel.m_channel_id)->getTimeBase().m_frequency);
                 }
+                // the slots are assigned before prepareProcessing, adding channels here could move iterators plugins refer to
+                const auto slot = iterators.getSlot(channel.m_channel_id);
+                if (slot == ChannelIteratorTable::NO_SLOT)
+                {
+                    continue;
+                }
+                auto& iterator = iterators.getIterator(slot);
+                // a reused iterator starts over like a new one, only its memory is kept
+                iterator.clearRanges();
+                iterator.setSignalGaps(false);
+                iterator.setSkipGaps(true);
                 try
                 {
-                    iterators[channel.m_channel_id] = stream_reader.createChannelIterator(channel.m_channel_id, channel_interval);
+                    m_stream_reader.updateStreamIterator(channel.m_channel_id, iterator, channel_interval);
                     auto channel_proxy = getInputChannelProxyChecked(channel.m_channel_id);
                     if(channel_proxy)
                     {
-                        iterators[channel.m_channel_id].setTimebase(channel_proxy->getTimeBase());
+                        iterator.setTimebase(channel_proxy->getTimeBase());
                     }
                 }
                 catch (std::out_of_range&)
@@ -123,8 +175,6 @@ namespace framework
                 }
             }
         }
-
-        return iterators;
     }
 
     SoftwareChannelInstance::InitResult SoftwareChannelInstance::init(const InitParams& params)
@@ -315,6 +365,7 @@ namespace framework
                 }
             }
 
+            assignChannelSlots();
             prepareProcessing(host);
             return;
         }
@@ -354,6 +405,7 @@ namespace framework
 
                 m_dataset_descriptor = std::nullopt;
             }
+            m_processing_context.m_channel_iterators.clear();
 
             stopProcessing(host);
             return;
@@ -374,14 +426,15 @@ namespace framework
     {
         if(m_dataset_descriptor)
         {
-            auto xml_msg = m_host->createValue<odk::IfXMLValue>();
+            auto host = getHost();
+            auto xml_msg = host->createValue<odk::IfXMLValue>();
             if (xml_msg)
             {
                 PluginDataRequest req(m_dataset_descriptor->m_id, PluginDataRequest::SingleValue(time));
                 xml_msg->set(req.generate().c_str());
 
                 const odk::IfValue* response = nullptr;
-                if (0 != m_host->messageSync(odk::host_msg::DATA_READ, 0, xml_msg.get(), &response))
+                if (0 != host->messageSync(odk::host_msg::DATA_READ, 0, xml_msg.get(), &response))
                 {
                     return {};
                 }
@@ -399,6 +452,7 @@ namespace framework
     void SoftwareChannelInstance::onProcess(odk::IfHost *host, std::uint64_t token, const odk::IfXMLValue* param)
     {
         ODK_UNUSED(token);
+        ProcessingHostScope host_scope(m_processing_host, host);
 
         std::uint64_t ret = odk::error_codes::OK;
         odk::AcquisitionTaskProcessTelegram telegram;
@@ -407,43 +461,25 @@ namespace framework
             telegram.parse(param->asStringView());
         }
 
-        ProcessingContext context;
+        // the context is kept across calls, so neither the iterators nor the scratch buffers allocate in steady state
+        ProcessingContext& context = m_processing_context;
         const auto master_timebase = getMasterTimestamp(host);
         context.m_master_timestamp = master_timebase;
+        context.m_window = {};
+        context.m_scratch = &m_scratch_arena;
+        context.m_thread_pool = m_plugin_channels ? &m_plugin_channels->getThreadPool() : nullptr;
 
         if (m_dataset_descriptor && telegram.m_start.timestampValid() && telegram.m_end.timestampValid())
         {
-            odk::DataRegions data_regions;
-            {
-                auto xml_msg = host->createValue<odk::IfXMLValue>();
-                if (xml_msg)
-                {
-                    double start = telegram.m_start.m_ticks / telegram.m_start.m_frequency;
-                    double end = telegram.m_end.m_ticks / telegram.m_end.m_frequency;
-                    PluginDataRegionsRequest req(m_dataset_descriptor->m_id);
-                    req.m_data_window = PluginDataRegionsRequest::DataWindow(start, end);
-                    xml_msg->set(req.generate().c_str());
-                }
-
-                const odk::IfValue* data_regions_result = nullptr;
-                host->messageSync(odk::host_msg::DATA_REGIONS_READ, 0, xml_msg.get(), &data_regions_result);
+            const double start = telegram.m_start.m_ticks / telegram.m_start.m_frequency;
+            const double end = telegram.m_end.m_ticks / telegram.m_end.m_frequency;
 
-                const odk::IfXMLValue* data_regions_result_xml = odk::value_cast<odk::IfXMLValue>(data_regions_result);
-                if (data_regions_result)
-                {
-                    if (data_regions_result_xml)
-                    {
-                        data_regions.parse(data_regions_result_xml->asStringView());
-                    }
-                    data_regions_result->release();
-                }
-            }
+            // the data regions are requested along with the data, a single round trip on hosts supporting it
             auto xml_msg = host->createValue<odk::IfXMLValue>();
             if (xml_msg)
             {
-                double start = telegram.m_start.m_ticks / telegram.m_start.m_frequency;
-                double end = telegram.m_end.m_ticks / telegram.m_end.m_frequency;
                 PluginDataRequest req(m_dataset_descriptor->m_id, PluginDataRequest::DataWindow(start, end));
+                req.m_include_data_regions = true;
                 xml_msg->set(req.generate().c_str());
             }
 
@@ -469,13 +505,19 @@ namespace framework
                 context.m_window.first = list_descriptor.m_windows.front().m_begin;
                 context.m_window.second = list_descriptor.m_windows.back().m_end;
 
-                context.m_channel_iterators = createChannelIterators(m_dataset_descriptor->m_stream_descriptors,
+                odk::DataRegions data_regions;
+                data_regions.m_data_regions = getBlockListDataRegions(host, m_dataset_descriptor->m_id, list_descriptor, start, end);
+
+                updateChannelIterators(m_dataset_descriptor->m_stream_descriptors,
                     block_list,
                     odk::Interval<double>(context.m_window.first, context.m_window.second),
-                    data_regions);
+                    data_regions,
+                    context.m_channel_iterators);
 
+                m_scratch_arena.reset();
                 process(context, host);
                 response->release();
+                clearChannelIterators(context.m_channel_iterators);
             }
         }
         else if (m_dataset_descriptor && m_data_request_type == DataRequestType::STREAM)
@@ -512,10 +554,15 @@ namespace framework
                     context.m_window.first = list_descriptor.m_windows.front().m_begin;
                     context.m_window.second = list_descriptor.m_windows.back().m_end;
 
-                    context.m_channel_iterators = createChannelIterators(m_dataset_descriptor->m_stream_descriptors, block_list.ref());
+                    updateChannelIterators(m_dataset_descriptor->m_stream_descriptors,
+                        block_list.ref(),
+                        odk::Interval<double>(0, std::numeric_limits<double>::max()),
+                        getUnboundedDataRegions(m_dataset_descriptor->m_stream_descriptors),
+                        context.m_channel_iterators);
 
                     try
                     {
+                        m_scratch_arena.reset();
                         process(context, host);
                     }
                     catch (const std::exception& e)
@@ -530,6 +577,8 @@ namespace framework
                         ret = odk::error_codes::UNHANDLED_EXCEPTION;
                     }
 
+                    // block_list is released at the end of this iteration
+                    clearChannelIterators(context.m_channel_iterators);
                     current_time = context.m_window.second;
                 }
             }
@@ -538,9 +587,11 @@ namespace framework
         {
             context.m_window.first = convertTickToTime(telegram.m_start.m_ticks, telegram.m_start.m_frequency);
             context.m_window.second = convertTickToTime(telegram.m_end.m_ticks, telegram.m_end.m_frequency);
+            clearChannelIterators(context.m_channel_iterators);
 
             try
             {
+                m_scratch_arena.reset();
                 process(context, host);
             }
             catch (const std::exception& e)
@@ -557,8 +608,10 @@ namespace framework
         }
         else
         {
+            clearChannelIterators(context.m_channel_iterators);
             try
             {
+                m_scratch_arena.reset();
                 process(context, host);
             }
             catch (const std::exception& e)
@@ -665,6 +718,55 @@ namespace framework
         }
     }
 
+    void SoftwareChannelInstance::assignChannelSlots()
+    {
+        auto& iterators = m_processing_context.m_channel_iterators;
+        iterators.clear();
+        if (!m_dataset_descriptor)
+        {
+            return;
+        }
+
+        // slots follow the channel ids, iteration order is the same as with the former std::map
+        std::vector<std::uint64_t> channel_ids;
+        for (const auto& sd : m_dataset_descriptor->m_stream_descriptors)
+        {
+            for (const auto& channel : sd.m_channel_descriptors)
+            {
+                channel_ids.push_back(channel.m_channel_id);
+            }
+        }
+        std::sort(channel_ids.begin(), channel_ids.end());
+        for (const auto channel_id : channel_ids)
+        {
+            iterators.addChannel(channel_id);
+        }
+    }
+
+    std::size_t SoftwareChannelInstance::getChannelSlot(std::uint64_t channel_id) const
+    {
+        return m_processing_context.m_channel_iterators.getSlot(channel_id);
+    }
+
+    void SoftwareChannelInstance::parallelForChannels(ProcessingContext& context, const ChannelFunction& fn)
+    {
+        auto& iterators = context.m_channel_iterators;
+        if (!context.m_thread_pool)
+        {
+            for (std::size_t slot = 0; slot < iterators.size(); ++slot)
+            {
+                fn(slot, iterators.getIterator(slot));
+            }
+            return;
+        }
+
+        context.m_thread_pool->parallelFor(iterators.size(),
+            [&iterators, &fn](std::size_t slot)
+            {
+                fn(slot, iterators.getIterator(slot));
+            });
+    }
+
     bool SoftwareChannelInstance::containsChannel(std::uint32_t channel_id)
     {
         return std::find_if(m_output_channels.begin(),
@@ -1097,7 +1199,8 @@ namespace framework
 
     odk::IfHost* SoftwareChannelInstance::getHost()
     {
-        return m_host;
+        // with parallel processing the host of onProcess forwards calls to the host thread
+        return m_processing_host ? m_processing_host : m_host;
     }
 
 }
@@ -35,6 +35,7 @@ namespace framework
     {
         getPluginChannels()->pauseTasks();
         unregisterSoftwareChannel();
+        getPluginChannels()->shutdownThreads();
         return true;
     }
 
@@ -84,6 +85,11 @@ namespace framework
         return m_plugin_channels;
     }
 
+    void SoftwareChannelPluginBase::enableParallelProcessing(std::size_t thread_count)
+    {
+        m_plugin_channels->enableParallelProcessing(thread_count);
+    }
+
     std::shared_ptr<CustomRequestHandler> SoftwareChannelPluginBase::getCustomRequestHandler()
     {
         return m_custom_requests;
@@ -5,12 +5,82 @@
 #include "odkapi_block_descriptor_xml.h"
 #include "odkapi_utils.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace odk
 {
 namespace framework
 {
+    namespace
+    {
+        /**
+         * Moves position to the first sample of [position, end) with a timestamp at or after tick
+         * @return false if all samples of the range are before tick
+         */
+        bool seekInRange(BlockIterator& position, const BlockIterator& end, std::uint64_t tick)
+        {
+            switch (position.layout())
+            {
+                case BlockLayout::IMPLICIT_TIMESTAMP:
+                {
+                    const std::uint64_t count = position.data()
+                        ? position.distanceTo(end)
+                        : end.timestamp() - position.timestamp();
+                    const std::uint64_t offset = tick > position.timestamp() ? tick - position.timestamp() : 0;
+                    if (offset >= count)
+                    {
+                        return false;
+                    }
+                    position += offset;
+                    return true;
+                }
+                case BlockLayout::EXPLICIT_TIMESTAMP:
+                {
+                    std::uint64_t first = 0;
+                    std::uint64_t count = position.distanceTo(end);
+                    while (count > 0)
+                    {
+                        const std::uint64_t step = count / 2;
+                        BlockIterator mid = position;
+                        mid += first + step;
+                        if (mid.timestamp() < tick)
+                        {
+                            first += step + 1;
+                            count -= step + 1;
+                        }
+                        else
+                        {
+                            count = step;
+                        }
+                    }
+                    if (first == position.distanceTo(end))
+                    {
+                        return false;
+                    }
+                    position += first;
+                    return true;
+                }
+                case BlockLayout::DYNAMIC_SIZE:
+                    // samples cannot be addressed directly
+                    while (position != end)
+                    {
+                        if (position.timestamp() >= tick)
+                        {
+                            return true;
+                        }
+                        ++position;
+                    }
+                    return false;
+            }
+            return false;
+        }
+    }
+
     StreamIterator::StreamIterator() noexcept
-        : m_block_index(-1)
+        : m_gaps_valid(false)
+        , m_block_index(-1)
+        , m_layout(BlockLayout::IMPLICIT_TIMESTAMP)
         , m_data_requester(nullptr)
         , m_signal_gaps(false)
         , m_skip_gaps(true)
@@ -27,7 +97,7 @@ namespace framework
 
             if (m_block_index != static_cast<int>(m_blocks_ranges.size()))
             {
-                m_current_iterator = m_blocks_ranges[m_block_index].first;
+                setCurrentIterator(m_blocks_ranges[m_block_index].first);
             }
             else if(m_data_requester)
             {
@@ -51,27 +121,186 @@ namespace framework
             --m_block_index;
             if (m_block_index >= 0)
             {
-                m_current_iterator = m_blocks_ranges[m_block_index].second;
+                setCurrentIterator(m_blocks_ranges[m_block_index].second);
             }
             skip = valid() && m_skip_gaps && data() == nullptr;
         }
     }
 
-    void StreamIterator::addRange(const BlockIterator& begin, const BlockIterator& end)
+    BlockIterator StreamIterator::takeChunk(std::uint64_t max_count, std::size_t& count)
     {
-        auto predecessor = m_blocks_ranges.rbegin();
-        while(predecessor != m_blocks_ranges.rend())
+        count = 0;
+        while (valid() && max_count > 0)
         {
-            if(predecessor->first.timestamp() < begin.timestamp())
+            const BlockIterator begin = m_current_iterator;
+            const BlockIterator& block_end = m_blocks_ranges[m_block_index].second;
+
+            if (begin.hasDynamicSize())
+            {
+                // samples with dynamic size cannot be addressed by stride
+                count = 1;
+                ++(*this);
+                return begin;
+            }
+
+            const std::uint64_t available = begin.data()
+                ? begin.distanceTo(block_end)
+                : block_end.timestamp() - begin.timestamp();
+
+            if (available == 0)
+            {
+                getNextBlock();
+                continue;
+            }
+
+            count = static_cast<std::size_t>(std::min(available, max_count));
+            m_current_iterator += count;
+            if (m_current_iterator == block_end)
+            {
+                getNextBlock();
+            }
+            return begin;
+        }
+        return {};
+    }
+
+    StreamIterator& StreamIterator::operator+=(std::uint64_t count)
+    {
+        while (count > 0 && valid())
+        {
+            std::size_t skipped = 0;
+            takeChunk(count, skipped);
+            count -= skipped;
+        }
+        return *this;
+    }
+
+    bool StreamIterator::seek(std::uint64_t tick)
+    {
+        while (!m_blocks_ranges.empty())
+        {
+            // ranges are ordered by the timestamp of their first sample
+            auto next_range = std::upper_bound(m_blocks_ranges.begin(), m_blocks_ranges.end(), tick,
+                [](std::uint64_t value, const BlockIteratorRange& range)
+                {
+                    return value < range.first.timestamp();
+                });
+
+            if (next_range != m_blocks_ranges.begin())
+            {
+                auto range = std::prev(next_range);
+                BlockIterator position = range->first;
+                if (seekInRange(position, range->second, tick))
+                {
+                    m_block_index = static_cast<int>(range - m_blocks_ranges.begin());
+                    setCurrentIterator(position);
+                    if (m_skip_gaps && data() == nullptr)
+                    {
+                        getNextBlock();
+                    }
+                    return valid();
+                }
+            }
+
+            if (next_range != m_blocks_ranges.end())
+            {
+                m_block_index = static_cast<int>(next_range - m_blocks_ranges.begin());
+                setCurrentIterator(next_range->first);
+                if (m_skip_gaps && data() == nullptr)
+                {
+                    getNextBlock();
+                }
+                return valid();
+            }
+
+            // all samples are before tick, continue with the next data provided by the requester
+            if (!m_data_requester)
             {
                 break;
             }
-            ++predecessor;
+            m_block_index = static_cast<int>(m_blocks_ranges.size()) - 1;
+            getNextBlock();
+            if (!valid())
+            {
+                return false;
+            }
         }
-        m_blocks_ranges.emplace(predecessor.base(), begin, end);
 
+        m_block_index = -1;
+        setCurrentIterator({});
+        return false;
+    }
+
+    bool StreamIterator::seekTime(double time)
+    {
+        return seek(odk::convertTimeToTickAtOrAfter(time, m_timebase));
+    }
+
+    void StreamIterator::addRange(const BlockIterator& begin, const BlockIterator& end)
+    {
+        // insert in front of all ranges starting at the same time or later
+        if (m_blocks_ranges.empty() || m_blocks_ranges.back().first.timestamp() < begin.timestamp())
+        {
+            m_blocks_ranges.emplace_back(begin, end);
+        }
+        else
+        {
+            auto successor = std::lower_bound(m_blocks_ranges.begin(), m_blocks_ranges.end(), begin.timestamp(),
+                [](const BlockIteratorRange& range, std::uint64_t timestamp)
+                {
+                    return range.first.timestamp() < timestamp;
+                });
+            m_blocks_ranges.emplace(successor, begin, end);
+        }
+        m_gaps_valid = false;
+
+        resetPosition();
+    }
+
+    void StreamIterator::addRanges(std::vector<BlockIteratorRange>&& ranges)
+    {
+        if (ranges.empty())
+        {
+            return;
+        }
+
+        auto by_start = [](const BlockIteratorRange& lhs, const BlockIteratorRange& rhs)
+        {
+            return lhs.first.timestamp() < rhs.first.timestamp();
+        };
+        auto not_before = [&by_start](const BlockIteratorRange& lhs, const BlockIteratorRange& rhs)
+        {
+            return !by_start(lhs, rhs);
+        };
+
+        const bool strictly_ascending = std::adjacent_find(ranges.begin(), ranges.end(), not_before) == ranges.end();
+        if (strictly_ascending && (m_blocks_ranges.empty() || by_start(m_blocks_ranges.back(), ranges.front())))
+        {
+            if (m_blocks_ranges.empty())
+            {
+                m_blocks_ranges.swap(ranges);
+            }
+            else
+            {
+                m_blocks_ranges.insert(m_blocks_ranges.end(), ranges.begin(), ranges.end());
+            }
+        }
+        else
+        {
+            // same order as adding the ranges one by one with addRange: a range is placed in front of all ranges
+            // starting at the same time, so the new ranges go first in reverse order and the sort is stable
+            m_blocks_ranges.insert(m_blocks_ranges.begin(), ranges.rbegin(), ranges.rend());
+            std::stable_sort(m_blocks_ranges.begin(), m_blocks_ranges.end(), by_start);
+        }
+        m_gaps_valid = false;
+
+        resetPosition();
+    }
+
+    void StreamIterator::resetPosition()
+    {
         m_block_index = 0;
-        m_current_iterator = m_blocks_ranges.front().first;
+        setCurrentIterator(m_blocks_ranges.front().first);
         if (m_skip_gaps && data() == nullptr)
         {
             getNextBlock();
@@ -81,8 +310,18 @@ namespace framework
     void StreamIterator::clearRanges() noexcept
     {
         m_blocks_ranges.clear();
+        m_gaps.clear();
+        m_gaps_valid = false;
         m_block_index = -1;
-        m_current_iterator = {};
+        setCurrentIterator({});
+    }
+
+    std::vector<StreamIterator::BlockIteratorRange> StreamIterator::releaseRanges() noexcept
+    {
+        std::vector<BlockIteratorRange> ranges = std::move(m_blocks_ranges);
+        ranges.clear();
+        clearRanges();
+        return ranges;
     }
 
     void StreamIterator::setSignalGaps(bool enabled) noexcept
@@ -96,13 +335,39 @@ namespace framework
 
         if(!m_blocks_ranges.empty())
         {
-            m_block_index = 0;
-            m_current_iterator = m_blocks_ranges.front().first;
-            if (m_skip_gaps && data() == nullptr)
+            resetPosition();
+        }
+    }
+
+    void StreamIterator::updateGaps() const
+    {
+        m_gaps.clear();
+        for (const auto& range : m_blocks_ranges)
+        {
+            if (range.first.data() == nullptr && range.first.timestamp() < range.second.timestamp())
             {
-                getNextBlock();
+                m_gaps.emplace_back(range.first.timestamp(), range.second.timestamp());
             }
         }
+
+        // ranges are sorted by start already, merge overlapping gaps
+        std::size_t merged = 0;
+        for (std::size_t i = 1; i < m_gaps.size(); ++i)
+        {
+            if (m_gaps[i].first <= m_gaps[merged].second)
+            {
+                m_gaps[merged].second = std::max(m_gaps[merged].second, m_gaps[i].second);
+            }
+            else
+            {
+                m_gaps[++merged] = m_gaps[i];
+            }
+        }
+        if (!m_gaps.empty())
+        {
+            m_gaps.resize(merged + 1);
+        }
+        m_gaps_valid = true;
     }
 
     bool StreamIterator::isInGap(double timestamp) const
@@ -111,23 +376,22 @@ namespace framework
 
         if (m_blocks_ranges.empty()) return true;
 
-        for (auto rng = m_blocks_ranges.begin();
-            rng != m_blocks_ranges.end(); rng++)
+        if (!m_gaps_valid)
         {
-            bool interval_pause = rng->first.data() == nullptr;
+            updateGaps();
+        }
 
-            if(interval_pause)
+        // last gap starting at or before ts
+        auto next_gap = std::upper_bound(m_gaps.begin(), m_gaps.end(), ts,
+            [](std::uint64_t value, const std::pair<std::uint64_t, std::uint64_t>& gap)
             {
-                uint64_t interval_begin = rng->first.timestamp();
-                uint64_t interval_end = rng->second.timestamp();
-                if ((ts >= interval_begin) && (ts < interval_end))
-                {
-                    return true;
-                }
-            }
+                return value < gap.first;
+            });
+        if (next_gap == m_gaps.begin())
+        {
+            return false;
         }
-
-        return false;
+        return ts < std::prev(next_gap)->second;
     }
 
     void StreamIterator::setDataRequester(IfIteratorUpdater *requester) noexcept
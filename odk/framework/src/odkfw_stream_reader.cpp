@@ -1,6 +1,10 @@
 // Copyright DEWETRON GmbH 2017
+#define ODK_EXTENSION_FUNCTIONS
+
 #include "odkfw_stream_reader.h"
 #include "odkapi_data_set_descriptor_xml.h"
+#include "odkbase_api_object_ptr.h"
+#include "odkbase_basic_values.h"
 #include "odkuni_assert.h"
 
 #include <algorithm>
@@ -22,12 +26,48 @@ namespace framework
 
     void StreamReader::addDataBlock(const BlockDescriptor& block_descriptor, const void* data)
     {
-        m_blocks.emplace(block_descriptor.m_stream_id, std::make_tuple(block_descriptor, data));
+        addDataBlock(block_descriptor.m_stream_id, block_descriptor.m_data_size,
+            block_descriptor.m_block_channels.data(), block_descriptor.m_block_channels.size(), data);
     }
 
     void StreamReader::addDataBlock(BlockDescriptor&& block_descriptor, const void* data)
     {
-        m_blocks.emplace(block_descriptor.m_stream_id, std::make_tuple(std::move(block_descriptor), data));
+        addDataBlock(static_cast<const BlockDescriptor&>(block_descriptor), data);
+    }
+
+    void StreamReader::addDataBlock(std::uint64_t stream_id, std::uint64_t data_size,
+        const BlockChannelDescriptor* block_channels, std::size_t block_channel_count, const void* data)
+    {
+        BlockSlice slice;
+        slice.m_stream_id = stream_id;
+        slice.m_data_size = data_size;
+        slice.m_data = data;
+        slice.m_channel_count = block_channel_count;
+
+        for (std::size_t i = 0; i < block_channel_count; ++i)
+        {
+            if (block_channels[i].m_count > 0)
+            {
+                slice.m_channel = block_channels[i];
+                m_channel_blocks[slice.m_channel.m_channel_id].push_back(slice);
+            }
+        }
+    }
+
+    void StreamReader::addDataBlocks(const odk::IfDataBlockList* block_list)
+    {
+        const auto block_count = block_list->getBlockCount();
+        for (int i = 0; i < block_count; ++i)
+        {
+            auto block = odk::ptr(block_list->getBlock(i));
+            auto block_descriptor_xml = odk::ptr(block->getBlockDescription());
+
+            if (m_descriptor_cache.parse(block_descriptor_xml->asStringView(), m_parse_buffer)
+                && !m_parse_buffer.m_block_channels.empty())
+            {
+                addDataBlock(m_parse_buffer, block->data());
+            }
+        }
     }
 
     void StreamReader::addDataRegion(const odk::DataRegion& region)
@@ -59,6 +99,12 @@ namespace framework
         return getChannelDescriptor(channel_id) != nullptr;
     }
 
+    bool StreamReader::hasBlocks(const std::uint64_t channel_id) const
+    {
+        const auto channel_blocks = m_channel_blocks.find(channel_id);
+        return channel_blocks != m_channel_blocks.end() && !channel_blocks->second.empty();
+    }
+
     StreamIterator StreamReader::createChannelIterator(std::uint64_t channel_id) const
     {
         return createChannelIterator(channel_id, odk::Interval<std::uint64_t>(0, std::numeric_limits<std::uint64_t>::max()));
@@ -74,7 +120,8 @@ namespace framework
     void StreamReader::updateStreamIterator(std::uint64_t channel_id, StreamIterator& iterator, const odk::Interval<std::uint64_t>& interval) const
     {
         std::uint64_t sample_count = 0;
-        iterator.clearRanges();
+        // ranges are collected first and handed over to the iterator at once, reusing its memory
+        std::vector<StreamIterator::BlockIteratorRange> ranges = iterator.releaseRanges();
 
         auto channel_descriptor = getChannelDescriptor(channel_id);
         if (!channel_descriptor)
@@ -82,19 +129,17 @@ namespace framework
             throw std::runtime_error("Invalid channel ID");
         }
 
-        std::multimap<std::uint64_t, BlockDescriptorData>::const_iterator blocks_begin;
-        std::multimap<std::uint64_t, BlockDescriptorData>::const_iterator blocks_end;
-        std::tie(blocks_begin, blocks_end) = m_blocks.equal_range(m_stream_descriptor.m_stream_id);
-
-        for (auto it_block = blocks_begin; it_block != blocks_end; ++it_block)
+        const auto channel_blocks = m_channel_blocks.find(channel_id);
+        if (channel_blocks != m_channel_blocks.end())
         {
-            const BlockDescriptor& block_descriptor = std::get<0>(it_block->second);
-            const void* block_data = std::get<1>(it_block->second);
-
-            for (const auto& bcd : block_descriptor.m_block_channels)
+            ranges.reserve(channel_blocks->second.size());
+            for (const auto& slice : channel_blocks->second)
             {
-                if (bcd.m_channel_id == channel_id && bcd.m_count > 0)
-                {                    
+                if (slice.m_stream_id == m_stream_descriptor.m_stream_id)
+                {
+                    const BlockChannelDescriptor& bcd = slice.m_channel;
+                    const void* block_data = slice.m_data;
+
                     ODK_ASSERT_EQUAL(bcd.m_offset % 8, 0);
 
                     auto offset_bytes = bcd.m_offset / 8;
@@ -119,15 +164,15 @@ namespace framework
                             BlockIterator it_block_begin(channel_data, data_stride_bytes, reinterpret_cast<const uint64_t*>(channel_data + timestamp_pos_bytes), 
                                 data_stride_bytes, reinterpret_cast<const uint32_t*>(channel_data + sample_size_bytes), data_stride_bytes);
 
-                            if (block_descriptor.m_block_channels.size() == 1)
+                            if (slice.m_channel_count == 1)
                             {
-                                const std::uint8_t* data_end = channel_data + block_descriptor.m_data_size;
+                                const std::uint8_t* data_end = channel_data + slice.m_data_size;
 
                                 const std::uint64_t* ts_end = reinterpret_cast<const uint64_t*>(data_end + timestamp_pos_bytes);
                                 const std::uint32_t* size_end = reinterpret_cast<const uint32_t*>(data_end + sample_size_bytes);
 
                                 BlockIterator it_block_end(data_end, data_stride_bytes, ts_end, data_stride_bytes, size_end, data_stride_bytes);
-                                iterator.addRange(it_block_begin, it_block_end);
+                                ranges.emplace_back(it_block_begin, it_block_end);
                             }
                             else
                             {
@@ -138,7 +183,7 @@ namespace framework
                                     ++it_block_end;
                                 }
 
-                                iterator.addRange(it_block_begin, it_block_end);
+                                ranges.emplace_back(it_block_begin, it_block_end);
                             }
                         }
                         else
@@ -146,7 +191,7 @@ namespace framework
                             // Explicit Timestamp field
                             BlockIterator it_block_begin(channel_data, data_stride_bytes, reinterpret_cast<const uint64_t*>(channel_data + timestamp_pos_bytes), data_stride_bytes);
                             BlockIterator it_block_end(channel_data + data_stride_bytes * bcd.m_count, data_stride_bytes, reinterpret_cast<const std::uint64_t*>(channel_data + data_stride_bytes * bcd.m_count + timestamp_pos_bytes), data_stride_bytes);
-                            iterator.addRange(it_block_begin, it_block_end);
+                            ranges.emplace_back(it_block_begin, it_block_end);
                         }
                     }
                     else
@@ -154,7 +199,7 @@ namespace framework
                         // Implicit timestamps, incremented every sample
                         BlockIterator it_block_begin(channel_data, data_stride_bytes, bcd.m_first_sample_index);
                         BlockIterator it_block_end(channel_data + data_stride_bytes * bcd.m_count, data_stride_bytes, bcd.m_first_sample_index + bcd.m_count);
-                        iterator.addRange(it_block_begin, it_block_end);
+                        ranges.emplace_back(it_block_begin, it_block_end);
                     }
                     sample_count += bcd.m_count;
                 }
@@ -176,7 +221,7 @@ namespace framework
                 {
                     BlockIterator it_block_begin(invalid_region_start);
                     BlockIterator it_block_end(invalid_region_end);
-                    iterator.addRange(it_block_begin, it_block_end);
+                    ranges.emplace_back(it_block_begin, it_block_end);
                 }
 
                 invalid_region_start = valid_region.m_end;
@@ -189,16 +234,21 @@ namespace framework
         {
             BlockIterator it_block_begin(invalid_region_start);
             BlockIterator it_block_end(invalid_region_end);
-            iterator.addRange(it_block_begin, it_block_end);
+            ranges.emplace_back(it_block_begin, it_block_end);
         }
 
+        iterator.addRanges(std::move(ranges));
+
         ODK_UNUSED(sample_count);
         //ODK_ASSERT_EQUAL(iterator.getTotalSampleCount(), sample_count);
     }
 
     void StreamReader::clearBlocks()
     {
-        m_blocks.clear();
+        for (auto& channel_blocks : m_channel_blocks)
+        {
+            channel_blocks.second.clear();
+        }
         m_data_regions.clear();
     }
 
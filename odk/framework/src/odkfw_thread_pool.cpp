@@ -0,0 +1,205 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace odk
+{
+namespace framework
+{
+    namespace
+    {
+        /**
+         * State of a parallelFor call, shared with helper jobs that might start after the call returned
+         */
+        struct ParallelForState
+        {
+            const std::function<void(std::size_t)>* m_function = nullptr;
+            std::size_t m_count = 0;
+            std::atomic<std::size_t> m_next_index{0};
+            std::mutex m_mutex;
+            std::condition_variable m_finished;
+            std::size_t m_finished_count = 0;
+            std::exception_ptr m_error;
+
+            void work()
+            {
+                std::size_t finished = 0;
+                std::exception_ptr error;
+                for (auto index = m_next_index++; index < m_count; index = m_next_index++)
+                {
+                    try
+                    {
+                        (*m_function)(index);
+                    }
+                    catch (...)
+                    {
+                        if (!error)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                    ++finished;
+                }
+
+                if (finished > 0)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (error && !m_error)
+                    {
+                        m_error = error;
+                    }
+                    m_finished_count += finished;
+                    if (m_finished_count == m_count)
+                    {
+                        m_finished.notify_all();
+                    }
+                }
+            }
+        };
+    }
+
+    WorkStealingThreadPool::WorkStealingThreadPool(std::size_t thread_count)
+        : m_next_queue(0)
+        , m_queued_jobs(0)
+        , m_stop(false)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        m_queues.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+        {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        m_threads.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+        {
+            m_threads.emplace_back(&WorkStealingThreadPool::run, this, i);
+        }
+    }
+
+    WorkStealingThreadPool::~WorkStealingThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::size_t WorkStealingThreadPool::getThreadCount() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    void WorkStealingThreadPool::submit(Job job)
+    {
+        auto& queue = *m_queues[m_next_queue++ % m_queues.size()];
+        {
+            // count the job before it can be taken, otherwise takeJob could decrement first and wrap the counter
+            // pushing under m_wake_mutex keeps waiting workers from seeing the count before the job is queued
+            std::lock_guard<std::mutex> wake_lock(m_wake_mutex);
+            ++m_queued_jobs;
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            queue.m_jobs.push_back(std::move(job));
+        }
+        m_wake.notify_one();
+    }
+
+    void WorkStealingThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t index)>& fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count == 1)
+        {
+            fn(0);
+            return;
+        }
+
+        auto state = std::make_shared<ParallelForState>();
+        state->m_function = &fn;
+        state->m_count = count;
+
+        // helpers only call fn while indices are left, which keeps fn alive
+        const auto helper_count = std::min(count - 1, m_threads.size());
+        for (std::size_t i = 0; i < helper_count; ++i)
+        {
+            submit([state] { state->work(); });
+        }
+
+        state->work();
+
+        std::unique_lock<std::mutex> lock(state->m_mutex);
+        state->m_finished.wait(lock, [&state] { return state->m_finished_count == state->m_count; });
+        if (state->m_error)
+        {
+            std::rethrow_exception(state->m_error);
+        }
+    }
+
+    bool WorkStealingThreadPool::takeJob(std::size_t index, Job& job)
+    {
+        // own queue first (oldest job), then steal the newest job of another worker
+        for (std::size_t offset = 0; offset < m_queues.size(); ++offset)
+        {
+            auto& queue = *m_queues[(index + offset) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if (!queue.m_jobs.empty())
+            {
+                if (offset == 0)
+                {
+                    job = std::move(queue.m_jobs.front());
+                    queue.m_jobs.pop_front();
+                }
+                else
+                {
+                    job = std::move(queue.m_jobs.back());
+                    queue.m_jobs.pop_back();
+                }
+                --m_queued_jobs;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingThreadPool::run(std::size_t index)
+    {
+        while (true)
+        {
+            Job job;
+            if (takeJob(index, job))
+            {
+                try
+                {
+                    job();
+                }
+                catch (...)
+                {
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+            m_wake.wait(lock, [this] { return m_stop || m_queued_jobs > 0; });
+            if (m_stop && m_queued_jobs == 0)
+            {
+                return;
+            }
+        }
+    }
+}
+}
@@ -0,0 +1,199 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_background_source.h"
+#include "test_host.h"
+
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestBlock
+    {
+        std::uint64_t m_tick = 0;
+        std::size_t m_count = 0;
+        std::size_t m_emitted = 0;
+    };
+
+    /**
+     * Produces blocks of consecutive ticks up to a total number of ticks and records the emitted ticks
+     */
+    class TestSource : public odk::framework::BackgroundSourceInstance<TestBlock>
+    {
+    public:
+        using BackgroundSourceInstance::startProducer;
+        using BackgroundSourceInstance::stopProducer;
+
+        TestSource(std::size_t max_queued_blocks, std::size_t block_size, std::uint64_t tick_count)
+            : BackgroundSourceInstance<TestBlock>(max_queued_blocks)
+            , m_block_size(block_size)
+            , m_tick_count(tick_count)
+            , m_next_tick(0)
+            , m_produced_blocks(0)
+            , m_stopped(false)
+        {
+        }
+
+        ~TestSource()
+        {
+            stopProducer();
+        }
+
+        bool configure(const odk::UpdateChannelsTelegram& request,
+            std::map<uint32_t, uint32_t>& channel_id_map) final
+        {
+            ODK_UNUSED(request);
+            ODK_UNUSED(channel_id_map);
+            return true;
+        }
+
+        bool update() final
+        {
+            return true;
+        }
+
+        std::size_t m_block_size;
+        std::uint64_t m_tick_count;
+        std::uint64_t m_next_tick;
+        std::atomic<std::size_t> m_produced_blocks;
+        bool m_stopped;
+        std::vector<std::uint64_t> m_emitted_ticks;
+
+    protected:
+        double getSourceFrequency() const override
+        {
+            return 10.0;
+        }
+
+        bool startProducing(std::uint64_t first_tick) override
+        {
+            m_next_tick = first_tick;
+            m_stopped = false;
+            return first_tick < m_tick_count;
+        }
+
+        bool produceBlock(TestBlock& block) override
+        {
+            if (m_next_tick >= m_tick_count)
+            {
+                return false;
+            }
+            block.m_tick = m_next_tick;
+            block.m_count = static_cast<std::size_t>(std::min<std::uint64_t>(m_block_size, m_tick_count - m_next_tick));
+            block.m_emitted = 0;
+            m_next_tick += block.m_count;
+            ++m_produced_blocks;
+            return true;
+        }
+
+        void stopProducing() override
+        {
+            m_stopped = true;
+        }
+
+        bool emitBlock(TestBlock& block, std::uint64_t target_tick, odk::IfHost* host) override
+        {
+            ODK_UNUSED(host);
+            for (; block.m_emitted < block.m_count; ++block.m_emitted)
+            {
+                const auto tick = block.m_tick + block.m_emitted;
+                if (tick >= target_tick)
+                {
+                    return false;
+                }
+                m_emitted_ticks.push_back(tick);
+            }
+            return true;
+        }
+    };
+
+    bool waitFor(const std::function<bool()>& condition)
+    {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > timeout)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void process(TestSource& source, TestHost& host, std::uint64_t master_ticks)
+    {
+        odk::framework::SoftwareChannelInstance::ProcessingContext context;
+        context.m_master_timestamp = odk::Timestamp(master_ticks, 1.0);
+        source.process(context, &host);
+    }
+
+    std::vector<std::uint64_t> makeTicks(std::uint64_t begin, std::uint64_t end)
+    {
+        std::vector<std::uint64_t> ticks;
+        for (auto tick = begin; tick < end; ++tick)
+        {
+            ticks.push_back(tick);
+        }
+        return ticks;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(background_source_test_suite)
+
+BOOST_AUTO_TEST_CASE(back_pressure_test)
+{
+    TestHost host;
+    TestSource source(2, 10, 1000);
+    source.startProducer(0);
+
+    // the producer stops after filling all blocks
+    BOOST_REQUIRE(waitFor([&source] { return source.m_produced_blocks == 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(source.m_produced_blocks.load(), 2u);
+
+    // samples are emitted up to the master timestamp only (1s at 10Hz), the emitted block is refilled
+    process(source, host, 1);
+    process(source, host, 1);
+    BOOST_CHECK(source.m_emitted_ticks == makeTicks(0, 10));
+
+    BOOST_REQUIRE(waitFor([&source] { return source.m_produced_blocks == 3; }));
+    process(source, host, 2);
+    BOOST_CHECK(source.m_emitted_ticks == makeTicks(0, 20));
+    BOOST_REQUIRE(waitFor([&source] { return source.m_produced_blocks == 4; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(source.m_produced_blocks.load(), 4u);
+    BOOST_CHECK(source.isProducing());
+
+    source.stopProducer();
+    BOOST_CHECK(source.m_stopped);
+    BOOST_CHECK(!source.isProducing());
+}
+
+BOOST_AUTO_TEST_CASE(end_of_data_test)
+{
+    TestHost host;
+    TestSource source(3, 7, 100);
+    source.startProducer(20);
+
+    // data is emitted in order until the producer reaches the end
+    std::uint64_t master_ticks = 0;
+    BOOST_REQUIRE(waitFor([&]
+        {
+            process(source, host, ++master_ticks);
+            return !source.isProducing();
+        }));
+    BOOST_CHECK(source.m_emitted_ticks == makeTicks(20, 100));
+
+    // nothing is produced behind the end
+    source.startProducer(100);
+    BOOST_CHECK(!source.isProducing());
+    source.stopProducer();
+    BOOST_CHECK(!source.m_stopped);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
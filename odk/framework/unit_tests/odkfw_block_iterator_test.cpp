@@ -65,4 +65,47 @@ BOOST_AUTO_TEST_CASE(timepointer_block_iterator_test)
     BOOST_CHECK_EQUAL(it.distanceTo(it1), 1);
 }
 
+BOOST_AUTO_TEST_CASE(advance_block_iterator_test)
+{
+    const double data[] = {3.1415, 2.718, 1.618, 1.414};
+    const std::uint64_t timestamps[] = {1, 2, 5, 8};
+
+    BlockIterator it(data, sizeof(double), timestamps, sizeof(std::uint64_t));
+    it += 2;
+    BOOST_CHECK_EQUAL(it.data(), data + 2);
+    BOOST_CHECK_EQUAL(it.timestamp(), 5);
+
+    BlockIterator it_implicit(data, sizeof(double), 100);
+    it_implicit += 3;
+    BOOST_CHECK_EQUAL(it_implicit.data(), data + 3);
+    BOOST_CHECK_EQUAL(it_implicit.timestamp(), 103);
+
+    BlockIterator it_gap(10);
+    it_gap += 5;
+    BOOST_CHECK_EQUAL(it_gap.data(), nullptr);
+    BOOST_CHECK_EQUAL(it_gap.timestamp(), 15);
+}
+
+BOOST_AUTO_TEST_CASE(layout_block_iterator_test)
+{
+    const double data[] = {3.1415, 2.718, 1.618};
+    const std::uint64_t timestamps[] = {1, 2, 5};
+    const std::uint32_t sizes[] = {8, 8, 8};
+
+    BOOST_CHECK(BlockIterator(10).layout() == BlockLayout::IMPLICIT_TIMESTAMP);
+    BOOST_CHECK(BlockIterator(data, sizeof(double), 100).layout() == BlockLayout::IMPLICIT_TIMESTAMP);
+    BOOST_CHECK(BlockIterator(data, sizeof(double), timestamps, sizeof(std::uint64_t)).layout() == BlockLayout::EXPLICIT_TIMESTAMP);
+    BOOST_CHECK(BlockIterator(data, 0, timestamps, 0, sizes, 0).layout() == BlockLayout::DYNAMIC_SIZE);
+
+    BlockIterator it(data, sizeof(double), timestamps, sizeof(std::uint64_t));
+    it.increment<BlockLayout::EXPLICIT_TIMESTAMP>();
+    BOOST_CHECK_EQUAL(it.data(), data + 1);
+    BOOST_CHECK_EQUAL(it.timestamp(), 2);
+
+    BlockIterator it_implicit(data, sizeof(double), 100);
+    it_implicit.increment<BlockLayout::IMPLICIT_TIMESTAMP>();
+    BOOST_CHECK_EQUAL(it_implicit.data(), data + 1);
+    BOOST_CHECK_EQUAL(it_implicit.timestamp(), 101);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,64 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_channel_iterator_table.h"
+
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+
+using odk::framework::ChannelIteratorTable;
+
+BOOST_AUTO_TEST_SUITE(channel_iterator_table_test_suite)
+
+BOOST_AUTO_TEST_CASE(slot_test)
+{
+    ChannelIteratorTable table;
+    BOOST_CHECK(table.empty());
+
+    const auto slot_7 = table.addChannel(7);
+    const auto slot_3 = table.addChannel(3);
+    const auto slot_5 = table.addChannel(5);
+    BOOST_CHECK_EQUAL(slot_7, 0);
+    BOOST_CHECK_EQUAL(slot_3, 1);
+    BOOST_CHECK_EQUAL(slot_5, 2);
+    BOOST_CHECK_EQUAL(table.addChannel(3), slot_3);
+    BOOST_CHECK_EQUAL(table.size(), 3);
+
+    BOOST_CHECK_EQUAL(table.getSlot(5), slot_5);
+    BOOST_CHECK_EQUAL(table.getSlot(4), ChannelIteratorTable::NO_SLOT);
+    BOOST_CHECK_EQUAL(table.getChannelId(slot_3), 3);
+
+    // lookup by channel id and by slot refers to the same iterator
+    BOOST_CHECK_EQUAL(&table[3], &table.getIterator(slot_3));
+    BOOST_CHECK_EQUAL(&table.at(7), &table.getIterator(slot_7));
+    BOOST_CHECK_THROW(static_cast<void>(table.at(4)), std::out_of_range);
+    // unlike std::map, operator[] does not add unknown channels
+    BOOST_CHECK_THROW(static_cast<void>(table[4]), std::out_of_range);
+    BOOST_CHECK_EQUAL(table.size(), 3);
+    BOOST_CHECK(table.find(4) == table.end());
+    BOOST_CHECK_EQUAL(table.find(5)->first, 5);
+    BOOST_CHECK_EQUAL(table.count(5), 1);
+    BOOST_CHECK_EQUAL(table.count(4), 0);
+
+    // new channels are appended, existing slots stay valid
+    auto& iterator = table.getIterator(slot_5);
+    iterator.setSkipGaps(false);
+    table.addChannel(1);
+    BOOST_CHECK_EQUAL(table.getSlot(1), 3);
+    BOOST_CHECK_EQUAL(table.getSlot(5), slot_5);
+
+    std::vector<std::uint64_t> channel_ids;
+    for (const auto& [channel_id, channel_iterator] : table)
+    {
+        ODK_UNUSED(channel_iterator);
+        channel_ids.push_back(channel_id);
+    }
+    const std::vector<std::uint64_t> expected = { 7, 3, 5, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(channel_ids.begin(), channel_ids.end(), expected.begin(), expected.end());
+
+    table.clear();
+    BOOST_CHECK(table.empty());
+    BOOST_CHECK_EQUAL(table.getSlot(7), ChannelIteratorTable::NO_SLOT);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
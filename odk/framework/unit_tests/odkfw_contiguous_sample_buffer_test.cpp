@@ -0,0 +1,61 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_contiguous_sample_buffer.h"
+#include "test_host.h"
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(contiguous_sample_buffer_test_suite)
+
+BOOST_AUTO_TEST_CASE(payload_layout_test)
+{
+    odk::framework::ContiguousSampleBuffer<float> buffer;
+    BOOST_CHECK(buffer.empty());
+
+    buffer.push_back(1.0f);
+    buffer.push_back(2.0f);
+    buffer.push_back(3.0f);
+    BOOST_CHECK_EQUAL(buffer.size(), 3);
+    BOOST_CHECK_EQUAL(buffer.payloadSize(buffer.size()), sizeof(std::uint64_t) + 3 * sizeof(float));
+
+    // samples directly follow the timestamp slot
+    const auto* payload = static_cast<const std::uint8_t*>(buffer.payload());
+    BOOST_CHECK_EQUAL(static_cast<const void*>(payload + sizeof(std::uint64_t)), static_cast<const void*>(buffer.data()));
+
+    buffer.resize(5);
+    BOOST_CHECK_EQUAL(buffer[2], 3.0f);
+    BOOST_CHECK_EQUAL(buffer[4], 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(send_test)
+{
+    SampleRecordingHost<double> host;
+    odk::framework::ContiguousSampleBuffer<double> buffer(4);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        buffer[i] = static_cast<double>(i);
+    }
+
+    buffer.send(&host, 7, 1000);
+    BOOST_REQUIRE_EQUAL(host.m_blocks.size(), 1);
+    BOOST_CHECK_EQUAL(host.m_blocks[0].m_key, 7);
+    BOOST_CHECK_EQUAL(host.m_blocks[0].m_timestamp, 1000);
+    BOOST_CHECK_EQUAL(host.m_blocks[0].m_payload, buffer.payload());
+    const std::vector<double> expected = { 0, 1, 2, 3 };
+    const auto sent = host.getSamples(host.m_blocks[0]);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+
+    // partial send of a reused buffer
+    const void* memory = buffer.payload();
+    buffer.clear();
+    buffer.push_back(5.0);
+    buffer.push_back(6.0);
+    buffer.send(&host, 7, 2000, 1);
+    BOOST_REQUIRE_EQUAL(host.m_blocks.size(), 2);
+    BOOST_CHECK_EQUAL(host.m_blocks[1].m_timestamp, 2000);
+    BOOST_CHECK(host.getSamples(host.m_blocks[1]) == std::vector<double>({ 5.0 }));
+    BOOST_CHECK_EQUAL(buffer.payload(), memory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
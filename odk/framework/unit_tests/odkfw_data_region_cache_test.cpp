@@ -0,0 +1,74 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_data_region_cache.h"
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using odk::framework::DataRegionCache;
+
+namespace
+{
+    odk::DataRegion region(std::uint64_t channel_id, std::uint64_t begin, std::uint64_t end)
+    {
+        return odk::DataRegion(channel_id, odk::Interval<std::uint64_t>(begin, end));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(data_region_cache_test_suite)
+
+BOOST_AUTO_TEST_CASE(lookup_test)
+{
+    DataRegionCache cache;
+    BOOST_CHECK(!cache.covers(0, 1));
+
+    cache.setTickDuration(1, 0.001);
+    cache.setTickDuration(2, 0.01);
+    cache.assign({
+            region(1, 5000, 6000),
+            region(1, 0, 1000),
+            region(1, 500, 2000),   // overlaps the previous region
+            region(2, 300, 400),
+            region(3, 0, 100000),   // channel without timebase is dropped
+        }, 0.0, 10.0);
+
+    BOOST_CHECK(cache.covers(0.0, 10.0));
+    BOOST_CHECK(cache.covers(2.0, 3.0));
+    BOOST_CHECK(!cache.covers(9.0, 11.0));
+
+    auto regions = cache.getRegions(1.5, 3.5);
+    BOOST_REQUIRE_EQUAL(regions.size(), 2);
+    BOOST_CHECK_EQUAL(regions[0].m_channel_id, 1);
+    BOOST_CHECK_EQUAL(regions[0].m_region.m_begin, 0);
+    BOOST_CHECK_EQUAL(regions[0].m_region.m_end, 2000);
+    BOOST_CHECK_EQUAL(regions[1].m_channel_id, 2);
+    BOOST_CHECK_EQUAL(regions[1].m_region.m_begin, 300);
+
+    BOOST_CHECK(cache.getRegions(4.1, 4.9).empty());
+    // regions touching the window are included
+    BOOST_CHECK_EQUAL(cache.getRegions(4.0, 4.5).size(), 1);
+    BOOST_CHECK_EQUAL(cache.getRegions(1, 4.1, 7.0).size(), 1);
+    BOOST_CHECK(cache.getRegions(2, 4.1, 7.0).empty());
+    BOOST_CHECK(cache.getRegions(3, 0.0, 10.0).empty());
+
+    auto next_start = cache.getNextRegionStart(2.5);
+    BOOST_REQUIRE(next_start);
+    BOOST_CHECK_CLOSE(*next_start, 3.0, 1e-9);
+    next_start = cache.getNextRegionStart(3.5);
+    BOOST_REQUIRE(next_start);
+    BOOST_CHECK_CLOSE(*next_start, 5.0, 1e-9);
+    BOOST_CHECK(!cache.getNextRegionStart(5.5));
+
+    cache.clear();
+    BOOST_CHECK(!cache.covers(2.0, 3.0));
+    BOOST_CHECK(cache.getRegions(0.0, 10.0).empty());
+
+    // clear also forgets the channels, regions of channels without a new tick duration are dropped
+    cache.setTickDuration(2, 0.01);
+    cache.assign({ region(1, 0, 1000), region(2, 0, 100) }, 0.0, 10.0);
+    regions = cache.getRegions(0.0, 10.0);
+    BOOST_REQUIRE_EQUAL(regions.size(), 1);
+    BOOST_CHECK_EQUAL(regions[0].m_channel_id, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,423 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_data_requester.h"
+#include "odkfw_input_channel.h"
+#include "odkapi_block_descriptor_xml.h"
+#include "odkapi_channel_dataformat_xml.h"
+#include "odkapi_error_codes.h"
+#include "odkapi_timebase_xml.h"
+#include "test_host.h"
+#include "values.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+using namespace odk::framework;
+
+namespace
+{
+    /**
+     * Serves a recording of CHANNEL_COUNT synchronous double channels, each sample value encodes channel id and tick
+     */
+    class DataHost : public TestHost
+    {
+    public:
+        static constexpr std::uint64_t CHANNEL_COUNT = 4;
+        static constexpr double SAMPLE_RATE = 100000;
+        static constexpr std::uint64_t SAMPLE_COUNT = 1000000;
+
+        static double sampleValue(std::uint64_t channel_id, std::uint64_t tick)
+        {
+            return static_cast<double>(channel_id * SAMPLE_COUNT + tick);
+        }
+
+        std::uint64_t PLUGIN_API messageSync(odk::MessageId msg_id, std::uint64_t key, const odk::IfValue* param, const odk::IfValue** ret) override
+        {
+            ODK_UNUSED(key);
+            switch (msg_id)
+            {
+            case odk::host_msg::DATA_GROUP_ADD:
+            {
+                odk::PluginDataSet data_set;
+                BOOST_REQUIRE(data_set.parse(xmlParam(param)));
+                m_data_sets[data_set.m_id] = data_set.m_channels;
+                m_last_data_set = data_set.m_id;
+
+                odk::DataSetDescriptor descriptor;
+                descriptor.m_id = data_set.m_id;
+                odk::StreamDescriptor stream;
+                stream.m_stream_id = 1;
+                for (auto channel_id : data_set.m_channels)
+                {
+                    odk::ChannelDescriptor channel;
+                    channel.m_channel_id = channel_id;
+                    channel.m_stride = 64;
+                    channel.m_size = 64;
+                    channel.m_type = odk::SampleType::DOUBLE;
+                    channel.m_dimension = 1;
+                    stream.m_channel_descriptors.push_back(channel);
+                }
+                descriptor.m_stream_descriptors.push_back(stream);
+                *ret = new XmlValue(descriptor.generate());
+                return odk::error_codes::OK;
+            }
+
+            case odk::host_msg::DATA_GROUP_REMOVE:
+                return odk::error_codes::OK;
+
+            case odk::host_msg::DATA_READ:
+            {
+                ++m_read_count;
+                odk::PluginDataRequest request;
+                BOOST_REQUIRE(request.parse(xmlParam(param)));
+                BOOST_REQUIRE(request.m_data_window);
+                // the attribute is only sent if regions are needed
+                BOOST_CHECK(request.m_include_data_regions.value_or(true));
+                const auto& channels = dataSetChannels(request.m_id);
+                odk::BlockListDescriptor descriptor;
+                if (m_inline_regions && request.m_include_data_regions.value_or(false))
+                {
+                    descriptor.m_data_regions = dataRegions(channels, request.m_data_window->m_start);
+                }
+                *ret = createBlockList(channels, descriptor, toTick(request.m_data_window->m_start), toTick(request.m_data_window->m_stop));
+                return odk::error_codes::OK;
+            }
+
+            case odk::host_msg::DATA_REGIONS_READ:
+            {
+                ++m_regions_read_count;
+                odk::PluginDataRegionsRequest request;
+                BOOST_REQUIRE(request.parse(xmlParam(param)));
+                odk::DataRegions regions;
+                regions.m_data_regions = dataRegions(dataSetChannels(request.m_id), request.m_data_window ? request.m_data_window->m_start : 0.0);
+                *ret = new XmlValue(regions.generate());
+                return odk::error_codes::OK;
+            }
+
+            default:
+                return TestHost::messageSync(msg_id, key, param, ret);
+            }
+        }
+
+        const odk::IfValue* PLUGIN_API query(const char* context, const char* item, const odk::IfValue* param) override
+        {
+            if (boost::algorithm::starts_with(context, "#Oxygen#Channels#"))
+            {
+                if (boost::algorithm::equals(item, "DataFormat"))
+                {
+                    odk::ChannelDataformat data_format;
+                    data_format.m_sample_dimension = 1;
+                    data_format.m_sample_format = odk::ChannelDataformat::SampleFormat::DOUBLE;
+                    data_format.m_sample_value_type = odk::ChannelDataformat::SampleValueType::SAMPLE_VALUE_SCALAR;
+                    data_format.m_sample_occurrence = odk::ChannelDataformat::SampleOccurrence::SYNC;
+                    return new XmlValue(data_format.generate());
+                }
+                if (boost::algorithm::equals(item, "Timebase"))
+                {
+                    return new XmlValue(odk::Timebase(SAMPLE_RATE).generate());
+                }
+                if (boost::algorithm::equals(item, "SampleRate"))
+                {
+                    return new ScalarValue(SAMPLE_RATE, "Hz");
+                }
+            }
+            return TestHost::query(context, item, param);
+        }
+
+        std::atomic<std::uint64_t> m_read_count = 0;
+        std::atomic<std::uint64_t> m_regions_read_count = 0;
+        bool m_inline_regions = false;  ///< answer PluginDataRequest::m_include_data_regions
+
+    private:
+        static std::string_view xmlParam(const odk::IfValue* param)
+        {
+            auto xml = dynamic_cast<const odk::IfXMLValue*>(param);
+            BOOST_REQUIRE(xml);
+            return xml->getValue();
+        }
+
+        /**
+         * Requests written by hand in the tests use the channels of the last added data set
+         */
+        const std::vector<std::uint64_t>& dataSetChannels(std::uint64_t data_set_id) const
+        {
+            const auto data_set = m_data_sets.find(data_set_id);
+            return data_set != m_data_sets.end() ? data_set->second : m_data_sets.at(m_last_data_set);
+        }
+
+        static std::uint64_t toTick(double time)
+        {
+            return static_cast<std::uint64_t>(std::ceil(std::max(0.0, time) * SAMPLE_RATE));
+        }
+
+        static std::vector<odk::DataRegion> dataRegions(const std::vector<std::uint64_t>& channels, double start)
+        {
+            std::vector<odk::DataRegion> regions;
+            if (toTick(start) < SAMPLE_COUNT)
+            {
+                for (auto channel_id : channels)
+                {
+                    regions.emplace_back(channel_id, odk::Interval<std::uint64_t>(0, SAMPLE_COUNT));
+                }
+            }
+            return regions;
+        }
+
+        static DataBlockListValue* createBlockList(const std::vector<std::uint64_t>& channels, const odk::BlockListDescriptor& descriptor,
+            std::uint64_t begin, std::uint64_t end)
+        {
+            auto block_list = new DataBlockListValue(descriptor.generate());
+            end = std::min(end, SAMPLE_COUNT);
+            if (begin >= end)
+            {
+                return block_list;
+            }
+
+            // all channels in one block, one after the other
+            const auto count = end - begin;
+            odk::BlockDescriptor block(1, count * sizeof(double) * channels.size());
+            std::vector<std::uint8_t> data(block.m_data_size);
+            for (std::size_t i = 0; i < channels.size(); ++i)
+            {
+                odk::BlockChannelDescriptor channel;
+                channel.m_offset = static_cast<std::uint32_t>(i * count * sizeof(double) * 8);
+                channel.m_channel_id = channels[i];
+                channel.m_timestamp = begin;
+                channel.m_duration = count;
+                channel.m_first_sample_index = begin;
+                channel.m_count = count;
+                block.m_block_channels.push_back(channel);
+
+                for (std::uint64_t tick = begin; tick < end; ++tick)
+                {
+                    const double value = sampleValue(channels[i], tick);
+                    std::memcpy(data.data() + (i * count + tick - begin) * sizeof(double), &value, sizeof(double));
+                }
+            }
+            block_list->addBlock(new DataBlockValue(block.generate(), std::move(data)));
+            return block_list;
+        }
+
+        /// channels of every data set by id
+        std::map<std::uint64_t, std::vector<std::uint64_t>> m_data_sets;
+        std::uint64_t m_last_data_set = 0;
+    };
+
+    std::vector<std::shared_ptr<InputChannel>> createChannels(odk::IfHost* host)
+    {
+        std::vector<std::shared_ptr<InputChannel>> channels;
+        for (std::uint64_t channel_id = 1; channel_id <= DataHost::CHANNEL_COUNT; ++channel_id)
+        {
+            auto channel = std::make_shared<InputChannel>(host, channel_id);
+            channel->updateDataFormat();
+            channel->updateTimeBase();
+            channels.push_back(channel);
+        }
+        return channels;
+    }
+
+    bool checkSample(std::uint64_t channel_id, StreamIterator& iterator, std::uint64_t tick)
+    {
+        const bool match = iterator.valid()
+            && iterator.timestamp() == tick
+            && iterator.value<double>() == DataHost::sampleValue(channel_id, tick);
+        ++iterator;
+        return match;
+    }
+
+    void checkSamples(std::uint64_t channel_id, StreamIterator& iterator, std::uint64_t count)
+    {
+        std::uint64_t matches = 0;
+        for (std::uint64_t tick = 0; tick < count; ++tick)
+        {
+            matches += checkSample(channel_id, iterator, tick);
+        }
+        BOOST_CHECK_EQUAL(matches, count);
+        BOOST_CHECK(!iterator.valid());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(data_requester)
+
+BOOST_AUTO_TEST_CASE(data_requester_prefetch_test)
+{
+    DataHost host;
+    auto channels = createChannels(&host);
+
+    for (bool prefetch : {false, true})
+    {
+        DataRequester requester(&host, channels.front());
+        requester.setPrefetchEnabled(prefetch);
+        auto iterator = requester.getIterator(0, 10);
+        BOOST_REQUIRE(iterator);
+        checkSamples(1, *iterator, DataHost::SAMPLE_COUNT);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(block_list_data_regions_test)
+{
+    DataHost host;
+    auto channels = createChannels(&host);
+    DataRequester requester(&host, channels.front());
+
+    for (bool inline_regions : {false, true})
+    {
+        host.m_inline_regions = inline_regions;
+        host.m_regions_read_count = 0;
+
+        odk::PluginDataRequest request(0, odk::PluginDataRequest::DataWindow(1.0, 2.0));
+        request.m_include_data_regions = true;
+        const odk::IfValue* response = nullptr;
+        XmlValue xml_request(request.generate());
+        BOOST_REQUIRE_EQUAL(host.messageSync(odk::host_msg::DATA_READ, 0, &xml_request, &response), odk::error_codes::OK);
+        auto block_list = odk::ptr(odk::value_cast<odk::IfDataBlockList>(response));
+        BOOST_REQUIRE(block_list);
+
+        const auto regions = getBlockListDataRegions(&host, 0, block_list.get(), 1.0, 2.0);
+        BOOST_CHECK_EQUAL(regions.size(), 1);
+        // a separate request is only needed if the host did not send the regions along
+        BOOST_CHECK_EQUAL(host.m_regions_read_count.load(), inline_regions ? 0 : 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(data_requester_region_cache_test)
+{
+    DataHost host;
+    auto channels = createChannels(&host);
+
+    DataRequester requester(&host, channels.front());
+    auto iterator = requester.getIterator(0, 10);
+    BOOST_REQUIRE(iterator);
+    checkSamples(1, *iterator, DataHost::SAMPLE_COUNT);
+
+    MultiChannelDataRequester multi_requester(&host, channels);
+    auto iterators = multi_requester.getIterators(0, 10);
+    BOOST_REQUIRE_EQUAL(iterators.size(), DataHost::CHANNEL_COUNT);
+    checkSamples(2, *iterators.at(2), DataHost::SAMPLE_COUNT);
+
+    // the regions of the whole interval are requested once, windows look them up locally
+    BOOST_CHECK_GT(host.m_read_count.load(), 2);
+    BOOST_CHECK_EQUAL(host.m_regions_read_count.load(), 2);
+    BOOST_CHECK_EQUAL(requester.getDataRegions(1.0, 2.0).size(), 1);
+    BOOST_CHECK_EQUAL(multi_requester.getDataRegions(1.0, 2.0).size(), DataHost::CHANNEL_COUNT);
+    BOOST_CHECK_EQUAL(host.m_regions_read_count.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(multi_channel_data_requester_test)
+{
+    DataHost host;
+    auto channels = createChannels(&host);
+
+    for (bool prefetch : {false, true})
+    {
+        host.m_read_count = 0;
+        MultiChannelDataRequester requester(&host, channels);
+        requester.setPrefetchEnabled(prefetch);
+        auto iterators = requester.getIterators(0, 10);
+        BOOST_REQUIRE_EQUAL(iterators.size(), DataHost::CHANNEL_COUNT);
+
+        // advance all channels together
+        std::uint64_t matches = 0;
+        for (std::uint64_t tick = 0; tick < DataHost::SAMPLE_COUNT; ++tick)
+        {
+            for (auto& iterator : iterators)
+            {
+                matches += checkSample(iterator.first, *iterator.second, tick);
+            }
+        }
+        BOOST_CHECK_EQUAL(matches, DataHost::SAMPLE_COUNT * DataHost::CHANNEL_COUNT);
+
+        // every window is read once for all channels
+        BOOST_CHECK_EQUAL(requester.getReadCount(), host.m_read_count.load());
+        BOOST_CHECK_GT(requester.getReadCount(), 1);
+        BOOST_CHECK_LT(requester.getReadCount(), 10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(multi_channel_data_requester_sequential_test)
+{
+    DataHost host;
+    auto channels = createChannels(&host);
+
+    MultiChannelDataRequester requester(&host, channels);
+    auto iterators = requester.getIterators(0, 10);
+    BOOST_REQUIRE_EQUAL(iterators.size(), DataHost::CHANNEL_COUNT);
+
+    // channels read one after the other, channels reaching a released window continue with their own data set
+    checkSamples(iterators.begin()->first, *iterators.begin()->second, DataHost::SAMPLE_COUNT);
+    const auto shared_read_count = requester.getReadCount();
+    for (auto& iterator : iterators)
+    {
+        if (iterator.first != iterators.begin()->first)
+        {
+            checkSamples(iterator.first, *iterator.second, DataHost::SAMPLE_COUNT);
+        }
+    }
+
+    // the shared windows are read once, lagging channels do not read the data of all channels again
+    BOOST_CHECK_EQUAL(requester.getReadCount(), shared_read_count);
+    BOOST_CHECK_GT(host.m_read_count.load(), shared_read_count);
+
+    // repositioning returns to the shared data set
+    iterators = requester.getIterators(0, 10);
+    BOOST_REQUIRE_EQUAL(iterators.size(), DataHost::CHANNEL_COUNT);
+    checkSamples(3, *iterators.at(3), DataHost::SAMPLE_COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(data_window_sizer_expected_rate_test)
+{
+    DataWindowSizer sizer(0.1, 8000, 1.0);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 0.1, 1e-9);
+
+    // 64 element double vectors at 1 kHz
+    sizer.setExpectedRate(1000.0 * 64 * 8);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 8000.0 / 512000.0, 1e-9);
+
+    sizer.setLimits(0.1, 10.0);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 0.1, 1e-9);
+
+    // 10 Hz scalar channel
+    sizer.setExpectedRate(10.0 * 8);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 10.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(data_window_sizer_update_test)
+{
+    DataWindowSizer sizer(1.0, 1000, 1.0);
+
+    // on budget: window stays
+    sizer.update(1.0, 1000, 0.01);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 1.0, 1e-9);
+
+    // small responses grow the window by at most factor two
+    sizer.update(1.0, 10, 0.01);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 2.0, 1e-9);
+
+    sizer.update(2.0, 1000, 0.01);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 2.0, 1e-9);
+
+    // large responses shrink the window by at most factor two
+    sizer.update(2.0, 100000, 0.01);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 1.0, 1e-9);
+
+    sizer.update(1.0, 1250, 0.01);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 0.8, 1e-9);
+
+    // slow responses shrink the window even below the byte budget
+    sizer.update(0.8, 500, 1.6);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 0.5, 1e-9);
+
+    sizer.setLimits(0.6, 1.0);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 0.6, 1e-9);
+    sizer.update(0.6, 100000, 10.0);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 0.6, 1e-9);
+    sizer.update(0.6, 1, 0.0);
+    BOOST_CHECK_CLOSE(sizer.getInterval(), 1.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
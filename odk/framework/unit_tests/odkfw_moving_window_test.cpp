@@ -0,0 +1,282 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_moving_window.h"
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using odk::framework::MovingWindow;
+
+namespace
+{
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+    const double INF = std::numeric_limits<double>::infinity();
+
+    std::vector<double> testSignal(std::size_t count, double offset)
+    {
+        std::vector<double> samples(count);
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            samples[n] = offset + std::sin(static_cast<double>(n) * 0.01) + static_cast<double>(n % 7) * 0.125;
+        }
+        return samples;
+    }
+
+    /**
+     * Previous implementation of the simple moving average example, summing the whole window for every output
+     */
+    std::vector<double> referenceAverages(const std::vector<double>& samples, std::size_t window_size)
+    {
+        std::vector<double> averages;
+        std::vector<double> window;
+        for (double sample : samples)
+        {
+            window.push_back(sample);
+            if (window.size() == window_size)
+            {
+                averages.push_back(std::accumulate(window.begin(), window.end(), 0.0) / window_size);
+                window.erase(window.begin());
+            }
+        }
+        return averages;
+    }
+
+    /**
+     * Feeds samples to addSamples in blocks of block_size
+     */
+    std::vector<double> batchAverages(MovingWindow<double>& window, const std::vector<double>& samples, std::size_t block_size)
+    {
+        std::vector<double> averages(samples.size());
+        std::size_t written = 0;
+        for (std::size_t start = 0; start < samples.size(); start += block_size)
+        {
+            const auto count = std::min(block_size, samples.size() - start);
+            written += window.addSamples(samples.data() + start, count, averages.data() + written);
+        }
+        averages.resize(written);
+        return averages;
+    }
+
+    void checkEqual(const std::vector<double>& actual, const std::vector<double>& expected, double tolerance)
+    {
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (std::size_t n = 0; n < actual.size(); ++n)
+        {
+            if (std::isnan(expected[n]))
+            {
+                BOOST_REQUIRE(std::isnan(actual[n]));
+            }
+            else
+            {
+                BOOST_REQUIRE_SMALL(actual[n] - expected[n], tolerance);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(moving_window_test_suite)
+
+BOOST_AUTO_TEST_CASE(FillAndReset)
+{
+    MovingWindow<double> window(3);
+    BOOST_CHECK_EQUAL(window.getWindowSize(), 3);
+    BOOST_CHECK(std::isnan(window.getAverage()));
+
+    window.push(1);
+    window.push(2);
+    BOOST_CHECK(!window.isFull());
+    BOOST_CHECK_EQUAL(window.size(), 2);
+    BOOST_CHECK_EQUAL(window.getAverage(), 1.5);
+
+    window.push(3);
+    window.push(7);
+    BOOST_CHECK(window.isFull());
+    BOOST_CHECK_EQUAL(window.getSum(), 12);
+    BOOST_CHECK_EQUAL(window.getAverage(), 4);
+
+    window.reset();
+    BOOST_CHECK_EQUAL(window.size(), 0);
+    BOOST_CHECK_EQUAL(window.getSum(), 0);
+
+    window.setWindowSize(0);
+    BOOST_CHECK_EQUAL(window.getWindowSize(), 1);
+    window.push(5);
+    BOOST_CHECK_EQUAL(window.getAverage(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesReference)
+{
+    const auto samples = testSignal(5000, 10.0);
+    for (std::size_t window_size : { 1, 2, 3, 64, 1000 })
+    {
+        const auto expected = referenceAverages(samples, window_size);
+
+        MovingWindow<double> single(window_size);
+        std::vector<double> averages;
+        for (double sample : samples)
+        {
+            single.push(sample);
+            if (single.isFull())
+            {
+                averages.push_back(single.getAverage());
+            }
+        }
+        checkEqual(averages, expected, 1e-10);
+
+        // block sizes below, at and above the window size, spans wrap around the ring buffer at different points
+        for (std::size_t block_size : { std::size_t(1), std::size_t(7), window_size, window_size * 3 + 1 })
+        {
+            MovingWindow<double> batch(window_size);
+            checkEqual(batchAverages(batch, samples, block_size), expected, 1e-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NanGap)
+{
+    auto samples = testSignal(1000, 0.0);
+    std::fill(samples.begin() + 300, samples.begin() + 320, NaN);
+    samples[700] = NaN;
+
+    const std::size_t window_size = 50;
+    const auto expected = referenceAverages(samples, window_size);
+    BOOST_REQUIRE(std::isnan(expected[300]));
+    BOOST_REQUIRE(!std::isnan(expected[320]));
+
+    // averages are NaN exactly while a NaN sample is in the window, the running sum is valid again afterwards
+    MovingWindow<double> window(window_size);
+    checkEqual(batchAverages(window, samples, 64), expected, 1e-10);
+    BOOST_CHECK_EQUAL(window.getNonFiniteCount(), 0);
+
+    // a window filled with NaN samples only restarts the running sum
+    window.reset();
+    for (std::size_t n = 0; n < window_size; ++n)
+    {
+        window.push(1e9 + 0.1 * static_cast<double>(n));
+    }
+    for (std::size_t n = 0; n < window_size; ++n)
+    {
+        window.push(NaN);
+    }
+    BOOST_CHECK_EQUAL(window.getNonFiniteCount(), window_size);
+    window.push(2.0);
+    BOOST_CHECK(std::isnan(window.getAverage()));
+    for (std::size_t n = 1; n < window_size; ++n)
+    {
+        window.push(2.0);
+    }
+    BOOST_CHECK_EQUAL(window.getAverage(), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(InfiniteSamples)
+{
+    auto samples = testSignal(1000, 0.0);
+    samples[200] = INF;
+    samples[500] = -INF;
+    samples[520] = INF;
+
+    // the previous implementation recovers once the infinities left the window, non-finite sums are reported as NaN
+    const std::size_t window_size = 50;
+    auto expected = referenceAverages(samples, window_size);
+    for (auto& average : expected)
+    {
+        if (!std::isfinite(average))
+        {
+            average = NaN;
+        }
+    }
+    BOOST_REQUIRE(!std::isnan(expected.back()));
+
+    for (std::size_t block_size : { std::size_t(1), std::size_t(64) })
+    {
+        MovingWindow<double> window(window_size);
+        checkEqual(batchAverages(window, samples, block_size), expected, 1e-10);
+        BOOST_CHECK_EQUAL(window.getNonFiniteCount(), 0);
+    }
+
+    MovingWindow<double> single(3);
+    single.push(INF);
+    single.push(1.0);
+    BOOST_CHECK_EQUAL(single.getNonFiniteCount(), 1);
+    BOOST_CHECK(std::isnan(single.getAverage()));
+    single.push(2.0);
+    single.push(3.0);
+    BOOST_CHECK_EQUAL(single.getAverage(), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(CompensatedSum)
+{
+    // a large offset and many samples, an uncompensated running sum drifts away from the true window sum
+    const std::size_t window_size = 1000;
+    const auto samples = testSignal(1000000, 1e6);
+
+    MovingWindow<double> window(window_size);
+    std::vector<double> averages(samples.size());
+    const auto written = window.addSamples(samples.data(), samples.size(), averages.data());
+    BOOST_REQUIRE_EQUAL(written, samples.size() - window_size + 1);
+
+    double running_sum = 0;
+    for (std::size_t n = 0; n < samples.size(); ++n)
+    {
+        running_sum += samples[n];
+        if (n >= window_size)
+        {
+            running_sum -= samples[n - window_size];
+        }
+    }
+
+    const double exact = std::accumulate(samples.end() - window_size, samples.end(), 0.0);
+    BOOST_TEST_MESSAGE("error of the window sum after " << samples.size() << " samples: compensated " << std::abs(window.getSum() - exact)
+        << ", uncompensated " << std::abs(running_sum - exact));
+    BOOST_CHECK_SMALL(window.getSum() - exact, 1e-6);
+    BOOST_CHECK_SMALL(averages[written - 1] - exact / window_size, 1e-9);
+
+    MovingWindow<float> float_window(100);
+    for (std::size_t n = 0; n < 100000; ++n)
+    {
+        float_window.push(1000.0f + 0.1f * static_cast<float>(n % 10));
+    }
+    BOOST_CHECK_CLOSE(float_window.getAverage(), 1000.45f, 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(WindowSizeBenchmark)
+{
+    const auto samples = testSignal(100000, 1.0);
+
+    for (std::size_t window_size : { 10, 100, 1000, 10000 })
+    {
+        MovingWindow<double> window(window_size);
+        auto start = std::chrono::steady_clock::now();
+        batchAverages(window, samples, 1000);
+        const std::chrono::duration<double> batch_time = std::chrono::steady_clock::now() - start;
+
+        MovingWindow<double> single(window_size);
+        double checksum = 0;
+        start = std::chrono::steady_clock::now();
+        for (double sample : samples)
+        {
+            single.push(sample);
+            checksum += single.getAverage();
+        }
+        const std::chrono::duration<double> single_time = std::chrono::steady_clock::now() - start;
+
+        // the previous implementation is O(window size) per sample, only a part of the signal is averaged
+        const std::vector<double> reference_samples(samples.begin(), samples.begin() + std::min(samples.size(), window_size + 2000000 / window_size));
+        start = std::chrono::steady_clock::now();
+        const auto reference = referenceAverages(reference_samples, window_size);
+        const std::chrono::duration<double> reference_time = std::chrono::steady_clock::now() - start;
+
+        BOOST_CHECK_CLOSE(window.getAverage(), single.getAverage(), 1e-9);
+        BOOST_CHECK_GT(checksum, 0);
+        BOOST_CHECK_EQUAL(reference.size(), reference_samples.size() - window_size + 1);
+        BOOST_TEST_MESSAGE("window " << window_size << ": addSamples " << samples.size() / batch_time.count() * 1e-6 << " MS/s, push "
+            << samples.size() / single_time.count() * 1e-6 << " MS/s, previous implementation "
+            << reference_samples.size() / reference_time.count() * 1e-6 << " MS/s");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
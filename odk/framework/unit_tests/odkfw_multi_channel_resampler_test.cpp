@@ -0,0 +1,190 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_multi_channel_resampler.h"
+#include "odkfw_resampler.h"
+#include "odkapi_message_ids.h"
+#include "test_host.h"
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using odk::framework::MultiChannelResampler;
+using odk::framework::Resampler;
+
+namespace
+{
+    /**
+     * Only counts the sent bytes, so benchmarks measure the resampling
+     */
+    class CountingHost : public TestHost
+    {
+    public:
+        std::uint64_t PLUGIN_API messageSyncData(odk::MessageId msg_id, std::uint64_t key, const void* param, std::uint64_t param_size, const odk::IfValue** ret) override
+        {
+            ODK_UNUSED(msg_id);
+            ODK_UNUSED(key);
+            ODK_UNUSED(param);
+            ODK_UNUSED(ret);
+            m_bytes += param_size;
+            return 0;
+        }
+
+        std::uint64_t m_bytes = 0;
+    };
+
+    double signal(std::size_t channel, std::size_t sample)
+    {
+        return std::sin(static_cast<double>(sample) * 1e-2 * static_cast<double>(channel + 1)) + static_cast<double>(channel);
+    }
+
+    /**
+     * Block timestamps of a source running 0.3% fast with jitter of a fraction of a sample
+     */
+    double blockTimestamp(std::size_t block, std::size_t block_size, double nominal_rate)
+    {
+        const double real_rate = nominal_rate * 1.003;
+        const double jitter = (block % 3 == 0 ? 0.3 : -0.2) / real_rate;
+        return static_cast<double>((block + 1) * block_size) / real_rate + jitter;
+    }
+
+    /**
+     * Resamples CHANNEL_COUNT channels with one MultiChannelResampler and with one Resampler per channel
+     */
+    void compareWithSingleChannelResamplers(MultiChannelResampler::Layout layout)
+    {
+        constexpr std::size_t CHANNEL_COUNT = 4;
+        constexpr std::size_t BLOCK_SIZE = 97;
+        constexpr std::size_t BLOCK_COUNT = 50;
+        const double nominal_rate = 1000;
+        const std::vector<std::uint32_t> channel_ids = { 10, 11, 12, 13 };
+
+        MultiChannelResampler multi_resampler(CHANNEL_COUNT, nominal_rate, layout);
+        BOOST_CHECK_EQUAL(multi_resampler.getChannelCount(), CHANNEL_COUNT);
+        std::vector<Resampler> resamplers(CHANNEL_COUNT, Resampler(nominal_rate));
+        SampleRecordingHost<double> multi_host;
+        SampleRecordingHost<double> single_host;
+
+        std::vector<double> block(CHANNEL_COUNT * BLOCK_SIZE);
+        std::vector<double> channel_block(BLOCK_SIZE);
+        for (std::size_t b = 0; b < BLOCK_COUNT; ++b)
+        {
+            const double timestamp = blockTimestamp(b, BLOCK_SIZE, nominal_rate);
+            for (std::size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+            {
+                for (std::size_t n = 0; n < BLOCK_SIZE; ++n)
+                {
+                    const double value = signal(channel, b * BLOCK_SIZE + n);
+                    channel_block[n] = value;
+                    if (layout == MultiChannelResampler::Layout::INTERLEAVED)
+                    {
+                        block[n * CHANNEL_COUNT + channel] = value;
+                    }
+                    else
+                    {
+                        block[channel * BLOCK_SIZE + n] = value;
+                    }
+                }
+                resamplers[channel].addSamples(&single_host, channel_ids[channel], timestamp, channel_block.data(), BLOCK_SIZE);
+            }
+            multi_resampler.addSamples(&multi_host, channel_ids.data(), timestamp, block.data(), BLOCK_SIZE);
+            BOOST_REQUIRE_EQUAL(multi_resampler.getSampleCount(), resamplers.front().getSampleCount());
+        }
+
+        BOOST_REQUIRE_EQUAL(multi_host.m_samples.size(), CHANNEL_COUNT);
+        for (auto channel_id : channel_ids)
+        {
+            const auto& multi = multi_host.m_samples[channel_id];
+            const auto& single = single_host.m_samples[channel_id];
+            BOOST_CHECK(multi_host.isContiguous(channel_id));
+            BOOST_CHECK(single_host.isContiguous(channel_id));
+            BOOST_REQUIRE_EQUAL(multi.size(), single.size());
+            BOOST_REQUIRE_GT(multi.size(), BLOCK_SIZE * (BLOCK_COUNT - 1));
+            for (std::size_t n = 0; n < multi.size(); ++n)
+            {
+                BOOST_REQUIRE_SMALL(multi[n] - single[n], 1e-12);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(multi_channel_resampler_test_suite)
+
+BOOST_AUTO_TEST_CASE(InterleavedMatchesSingleChannel)
+{
+    compareWithSingleChannelResamplers(MultiChannelResampler::Layout::INTERLEAVED);
+}
+
+BOOST_AUTO_TEST_CASE(PlanarMatchesSingleChannel)
+{
+    compareWithSingleChannelResamplers(MultiChannelResampler::Layout::PLANAR);
+}
+
+BOOST_AUTO_TEST_CASE(ResetAndEmptyInput)
+{
+    SampleRecordingHost<double> host;
+    MultiChannelResampler resampler(2, 100);
+    const std::uint32_t channel_ids[] = { 1, 2 };
+    const std::vector<double> block = { 0, 10, 1, 11, 2, 12, 3, 13 };
+
+    resampler.addSamples(&host, channel_ids, 0.0, block.data(), 0);
+    BOOST_CHECK(host.m_samples.empty());
+
+    resampler.addSamples(&host, channel_ids, 0.04, block.data(), 4);
+    BOOST_CHECK_EQUAL(resampler.getSampleCount(), 3);
+    BOOST_CHECK(host.m_samples[1] == std::vector<double>({ 0, 1, 2 }));
+    BOOST_CHECK(host.m_samples[2] == std::vector<double>({ 10, 11, 12 }));
+
+    resampler.reset();
+    BOOST_CHECK_EQUAL(resampler.getSampleCount(), 0);
+    BOOST_CHECK_EQUAL(resampler.getLastTimestamp(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ChannelScalingBenchmark)
+{
+    constexpr std::size_t BLOCK_SIZE = 1000;
+    constexpr std::size_t BLOCK_COUNT = 100;
+    const double nominal_rate = 100000;
+
+    for (std::size_t channel_count : { 1, 16 })
+    {
+        std::vector<std::uint32_t> channel_ids(channel_count);
+        std::vector<double> block(channel_count * BLOCK_SIZE);
+        for (std::size_t channel = 0; channel < channel_count; ++channel)
+        {
+            channel_ids[channel] = static_cast<std::uint32_t>(channel);
+            for (std::size_t n = 0; n < BLOCK_SIZE; ++n)
+            {
+                block[channel * BLOCK_SIZE + n] = signal(channel, n);
+            }
+        }
+
+        CountingHost single_host;
+        std::vector<Resampler> resamplers(channel_count, Resampler(nominal_rate));
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t b = 0; b < BLOCK_COUNT; ++b)
+        {
+            for (std::size_t channel = 0; channel < channel_count; ++channel)
+            {
+                resamplers[channel].addSamples(&single_host, channel_ids[channel], blockTimestamp(b, BLOCK_SIZE, nominal_rate), block.data() + channel * BLOCK_SIZE, BLOCK_SIZE);
+            }
+        }
+        const std::chrono::duration<double> single_time = std::chrono::steady_clock::now() - start;
+
+        CountingHost multi_host;
+        MultiChannelResampler multi_resampler(channel_count, nominal_rate, MultiChannelResampler::Layout::PLANAR);
+        start = std::chrono::steady_clock::now();
+        for (std::size_t b = 0; b < BLOCK_COUNT; ++b)
+        {
+            multi_resampler.addSamples(&multi_host, channel_ids.data(), blockTimestamp(b, BLOCK_SIZE, nominal_rate), block.data(), BLOCK_SIZE);
+        }
+        const std::chrono::duration<double> multi_time = std::chrono::steady_clock::now() - start;
+
+        BOOST_CHECK_EQUAL(multi_host.m_bytes, single_host.m_bytes);
+        BOOST_TEST_MESSAGE(channel_count << " channels: " << channel_count << " Resamplers " << single_time.count() * 1e3
+            << " ms, MultiChannelResampler " << multi_time.count() * 1e3 << " ms");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,367 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_channels.h"
+#include "odkfw_parallel_task_executor.h"
+#include "odkfw_contiguous_sample_buffer.h"
+#include "odkfw_thread_pool.h"
+#include "test_host.h"
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using odk::framework::ParallelTaskExecutor;
+using odk::framework::WorkStealingThreadPool;
+
+namespace
+{
+    /**
+     * Records the sample messages and the threads the host was called from
+     */
+    class RecordingHost : public SampleRecordingHost<double>
+    {
+    public:
+        std::uint64_t PLUGIN_API messageSyncData(odk::MessageId msg_id, std::uint64_t key, const void* param, std::uint64_t param_size, const odk::IfValue** ret) override
+        {
+            m_threads.push_back(std::this_thread::get_id());
+            return SampleRecordingHost<double>::messageSyncData(msg_id, key, param, param_size, ret);
+        }
+
+        const odk::IfValue* PLUGIN_API query(const char* context, const char* item, const odk::IfValue* param) override
+        {
+            ODK_UNUSED(context);
+            ODK_UNUSED(item);
+            ODK_UNUSED(param);
+            m_threads.push_back(std::this_thread::get_id());
+            return nullptr;
+        }
+
+        std::vector<std::thread::id> m_threads;
+    };
+
+    class ThrowingHost : public TestHost
+    {
+    public:
+        std::uint64_t PLUGIN_API messageSyncData(odk::MessageId msg_id, std::uint64_t key, const void* param, std::uint64_t param_size, const odk::IfValue** ret) override
+        {
+            ODK_UNUSED(msg_id);
+            ODK_UNUSED(key);
+            ODK_UNUSED(param);
+            ODK_UNUSED(param_size);
+            ODK_UNUSED(ret);
+            throw std::runtime_error("add samples failed");
+        }
+
+        const odk::IfValue* PLUGIN_API query(const char* context, const char* item, const odk::IfValue* param) override
+        {
+            ODK_UNUSED(context);
+            ODK_UNUSED(item);
+            ODK_UNUSED(param);
+            throw std::logic_error("query failed");
+        }
+    };
+
+    /**
+     * Counts the acquisition task registrations
+     */
+    class TaskHost : public TestHost
+    {
+    public:
+        std::uint64_t PLUGIN_API messageSync(odk::MessageId msg_id, std::uint64_t key, const odk::IfValue* param, const odk::IfValue** ret) override
+        {
+            ODK_UNUSED(param);
+            ODK_UNUSED(ret);
+            switch (msg_id)
+            {
+            case odk::host_msg::ACQUISITION_TASK_ADD:
+                ++m_task_adds;
+                return odk::error_codes::OK;
+            case odk::host_msg::ACQUISITION_TASK_REMOVE:
+                BOOST_CHECK_EQUAL(key, odk::framework::PluginChannels::TASK_GROUP_ID);
+                ++m_task_removes;
+                return odk::error_codes::OK;
+            default:
+                return TestHost::messageSync(msg_id, key, param, ret);
+            }
+        }
+
+        int m_task_adds = 0;
+        int m_task_removes = 0;
+    };
+
+    class CountingWorker : public odk::framework::IfTaskWorker
+    {
+    public:
+        void onStartProcessing(odk::IfHost* host, std::uint64_t token) override
+        {
+            ODK_UNUSED(host);
+            ODK_UNUSED(token);
+            ++m_starts;
+        }
+
+        void onProcess(odk::IfHost* host, std::uint64_t token, const odk::IfXMLValue* param) override
+        {
+            ODK_UNUSED(host);
+            ODK_UNUSED(token);
+            ODK_UNUSED(param);
+        }
+
+        void onStopProcessing(odk::IfHost* host, std::uint64_t token) override
+        {
+            ODK_UNUSED(host);
+            ODK_UNUSED(token);
+            ++m_stops;
+        }
+
+        int m_starts = 0;
+        int m_stops = 0;
+    };
+
+    double computeBlock(std::uint64_t seed, std::size_t size)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            sum += std::sin(static_cast<double>(seed + i) * 1e-3);
+        }
+        return sum;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(parallel_task_executor_test_suite)
+
+BOOST_AUTO_TEST_CASE(thread_pool_test)
+{
+    WorkStealingThreadPool pool(3);
+    BOOST_CHECK_EQUAL(pool.getThreadCount(), 3);
+
+    constexpr int JOB_COUNT = 1000;
+    std::atomic<int> executed(0);
+    std::mutex mutex;
+    std::condition_variable done;
+
+    for (int i = 0; i < JOB_COUNT; ++i)
+    {
+        pool.submit([&]
+            {
+                if (++executed == JOB_COUNT)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done.notify_all();
+                }
+            });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    BOOST_REQUIRE(done.wait_for(lock, std::chrono::seconds(10), [&] { return executed == JOB_COUNT; }));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_test)
+{
+    WorkStealingThreadPool pool(3);
+
+    std::vector<int> calls(100, 0);
+    pool.parallelFor(calls.size(), [&calls](std::size_t index) { ++calls[index]; });
+    BOOST_CHECK(std::all_of(calls.begin(), calls.end(), [](int count) { return count == 1; }));
+
+    // nested calls from pool threads are processed by the calling thread if the pool is busy
+    std::atomic<int> inner_calls(0);
+    pool.parallelFor(8, [&pool, &inner_calls](std::size_t)
+        {
+            pool.parallelFor(8, [&inner_calls](std::size_t) { ++inner_calls; });
+        });
+    BOOST_CHECK_EQUAL(inner_calls, 64);
+
+    BOOST_CHECK_THROW(pool.parallelFor(10, [](std::size_t index)
+        {
+            if (index == 5)
+            {
+                throw std::runtime_error("failed");
+            }
+        }), std::runtime_error);
+
+    pool.parallelFor(0, [](std::size_t) { BOOST_FAIL("no index expected"); });
+}
+
+BOOST_AUTO_TEST_CASE(host_calls_test)
+{
+    RecordingHost host;
+    ParallelTaskExecutor executor(4);
+
+    std::vector<ParallelTaskExecutor::Job> jobs;
+    for (std::uint64_t channel = 0; channel < 16; ++channel)
+    {
+        jobs.push_back([channel](odk::IfHost* job_host)
+            {
+                odk::framework::ContiguousSampleBuffer<double> buffer;
+                for (int block = 0; block < 10; ++block)
+                {
+                    buffer.clear();
+                    for (int i = 0; i < 100; ++i)
+                    {
+                        buffer.push_back(static_cast<double>(block * 100 + i));
+                    }
+                    buffer.send(job_host, channel, block);
+                }
+                job_host->query("test", "item", nullptr);
+            });
+    }
+
+    executor.run(&host, jobs);
+
+    // the host has only been called by the thread running the jobs
+    BOOST_CHECK_EQUAL(host.m_threads.size(), 16 * 11);
+    const auto this_thread = std::this_thread::get_id();
+    BOOST_CHECK(std::all_of(host.m_threads.begin(), host.m_threads.end(), [this_thread](std::thread::id id) { return id == this_thread; }));
+
+    BOOST_REQUIRE_EQUAL(host.m_samples.size(), 16);
+    for (const auto& [channel, samples] : host.m_samples)
+    {
+        BOOST_REQUIRE_EQUAL(samples.size(), 1000);
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            BOOST_REQUIRE_EQUAL(samples[i], static_cast<double>(i));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(exception_test)
+{
+    RecordingHost host;
+    ParallelTaskExecutor executor(2);
+
+    std::atomic<int> executed(0);
+    std::vector<ParallelTaskExecutor::Job> jobs(8, [&executed](odk::IfHost*) { ++executed; });
+    jobs[3] = [](odk::IfHost*) { throw std::runtime_error("failed"); };
+
+    BOOST_CHECK_THROW(executor.run(&host, jobs), std::runtime_error);
+    BOOST_CHECK_EQUAL(executed, 7);
+
+    // the executor is still usable afterwards
+    jobs[3] = [&executed](odk::IfHost*) { ++executed; };
+    executor.run(&host, jobs);
+    BOOST_CHECK_EQUAL(executed, 15);
+}
+
+BOOST_AUTO_TEST_CASE(host_call_exception_test)
+{
+    ThrowingHost host;
+    ParallelTaskExecutor executor(2);
+
+    // a host call waited for by the job throws on the job's thread
+    std::atomic<int> caught(0);
+    std::vector<ParallelTaskExecutor::Job> jobs(4, [&caught](odk::IfHost* job_host)
+        {
+            try
+            {
+                job_host->query("test", "item", nullptr);
+            }
+            catch (const std::logic_error&)
+            {
+                ++caught;
+            }
+        });
+    executor.run(&host, jobs);
+    BOOST_CHECK_EQUAL(caught, 4);
+
+    // nobody waits for queued samples, their exception is rethrown by run()
+    const double sample = 1.0;
+    jobs.assign(4, [&sample](odk::IfHost* job_host)
+        {
+            job_host->messageSyncData(odk::host_msg::ADD_SAMPLE, 1, &sample, sizeof(sample), nullptr);
+        });
+    BOOST_CHECK_THROW(executor.run(&host, jobs), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(task_group_restart_test)
+{
+    TaskHost host;
+    odk::framework::PluginChannels channels;
+    channels.setHost(&host);
+    channels.enableParallelProcessing(2);
+
+    auto worker_a = std::make_shared<CountingWorker>();
+    auto worker_b = std::make_shared<CountingWorker>();
+    auto task_a = channels.addTask(worker_a);
+    auto task_b = channels.addTask(worker_b);
+    task_a->addInputChannel(1);
+    task_b->addInputChannel(2);
+    task_a->setValid(true);
+    task_b->setValid(true);
+    channels.synchronize();
+    BOOST_CHECK_EQUAL(host.m_task_adds, 1);
+
+    odk::framework::IfMessageHandler& handler = channels;
+    handler.pluginMessage(odk::plugin_msg::ACQUISITION_TASK_START_PROCESSING, odk::framework::PluginChannels::TASK_GROUP_ID, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(worker_a->m_starts, 1);
+    BOOST_CHECK_EQUAL(worker_b->m_starts, 1);
+
+    // restarting one task keeps the group registered and the other worker running
+    channels.restartTask(task_a);
+    BOOST_CHECK_EQUAL(host.m_task_adds, 1);
+    BOOST_CHECK_EQUAL(host.m_task_removes, 0);
+    BOOST_CHECK_EQUAL(worker_a->m_stops, 1);
+    BOOST_CHECK_EQUAL(worker_a->m_starts, 2);
+    BOOST_CHECK_EQUAL(worker_b->m_stops, 0);
+    BOOST_CHECK_EQUAL(worker_b->m_starts, 1);
+
+    // other channels require registering the group again
+    task_b->addInputChannel(3);
+    channels.synchronize();
+    BOOST_CHECK_GT(host.m_task_removes, 0);
+    BOOST_CHECK_EQUAL(host.m_task_adds, host.m_task_removes + 1);
+    BOOST_CHECK_EQUAL(worker_b->m_stops, 1);
+
+    handler.pluginMessage(odk::plugin_msg::ACQUISITION_TASK_STOP_PROCESSING, odk::framework::PluginChannels::TASK_GROUP_ID, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(worker_a->m_stops, 2);
+    BOOST_CHECK_EQUAL(worker_b->m_stops, 1);
+}
+
+BOOST_AUTO_TEST_CASE(instance_scaling_benchmark)
+{
+    constexpr std::size_t BLOCK_SIZE = 20000;
+    constexpr std::size_t OUTPUT_SIZE = 1000;
+
+    ParallelTaskExecutor executor;
+    const auto thread_count = executor.getThreadCount();
+
+    for (std::size_t instance_count : { 1, 8, 32 })
+    {
+        std::vector<ParallelTaskExecutor::Job> jobs;
+        for (std::uint64_t instance = 0; instance < instance_count; ++instance)
+        {
+            jobs.push_back([instance](odk::IfHost* host)
+                {
+                    odk::framework::ContiguousSampleBuffer<double> buffer(OUTPUT_SIZE);
+                    std::fill(buffer.begin(), buffer.end(), computeBlock(instance, BLOCK_SIZE));
+                    buffer.send(host, instance, 0);
+                });
+        }
+
+        RecordingHost serial_host;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& job : jobs)
+        {
+            job(&serial_host);
+        }
+        const std::chrono::duration<double> serial_time = std::chrono::steady_clock::now() - start;
+
+        RecordingHost parallel_host;
+        start = std::chrono::steady_clock::now();
+        executor.run(&parallel_host, jobs);
+        const std::chrono::duration<double> parallel_time = std::chrono::steady_clock::now() - start;
+
+        BOOST_CHECK(parallel_host.m_samples == serial_host.m_samples);
+        BOOST_TEST_MESSAGE(instance_count << " instances on " << thread_count << " threads: serial "
+            << serial_time.count() * 1e3 << " ms, parallel " << parallel_time.count() * 1e3 << " ms");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_polyphase_resampler.h"
+#include "odkfw_resampler.h"
+#include "odkapi_message_ids.h"
+#include "test_host.h"
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using odk::framework::PolyphaseResampler;
+using odk::framework::Resampler;
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+
+    /**
+     * Feeds samples of signal(k) for input sample k at real_rate in blocks
+     */
+    template <class ResamplerType, class Signal>
+    void feed(ResamplerType& resampler, SampleRecordingHost<double>& host, double real_rate, std::size_t num_samples, std::size_t block_size, Signal signal)
+    {
+        std::vector<double> block;
+        for (std::size_t start = 0; start < num_samples; start += block_size)
+        {
+            const auto end = std::min(start + block_size, num_samples);
+            block.clear();
+            for (auto k = start; k < end; ++k)
+            {
+                block.push_back(signal(static_cast<double>(k)));
+            }
+            resampler.addSamples(&host, 0, static_cast<double>(end) / real_rate, block.data(), block.size());
+        }
+        BOOST_REQUIRE(host.isContiguous(0));
+        BOOST_REQUIRE(host.m_blocks.empty() || host.m_blocks.front().m_timestamp == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(polyphase_resampler_test_suite)
+
+BOOST_AUTO_TEST_CASE(ConstantSignal)
+{
+    SampleRecordingHost<double> host;
+    PolyphaseResampler resampler(100);
+    BOOST_CHECK_EQUAL(resampler.getTapCount(), 32);
+
+    feed(resampler, host, 101, 1000, 10, [](double) { return 3.0; });
+
+    // output ends half the filter length before the input
+    BOOST_CHECK_EQUAL(resampler.getSampleCount(), host.m_samples[0].size());
+    BOOST_CHECK_GT(host.m_samples[0].size(), 1000 * 100 / 101 - 20);
+    BOOST_CHECK_LE(host.m_samples[0].size(), 1000 * 100 / 101 - 16 + 1);
+    for (double value : host.m_samples[0])
+    {
+        BOOST_REQUIRE_CLOSE(value, 3.0, 1e-9);
+    }
+
+    resampler.reset();
+    BOOST_CHECK_EQUAL(resampler.getSampleCount(), 0);
+    BOOST_CHECK_EQUAL(resampler.getLastTimestamp(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SineAccuracy)
+{
+    const double nominal_rate = 1000;
+    const double real_rate = 1002;
+    const double frequency = 0.1 * real_rate;
+    auto signal = [&](double k) { return std::sin(2 * PI * frequency * k / real_rate); };
+
+    auto maxError = [&](const std::vector<double>& samples)
+    {
+        double error = 0;
+        // skip the start, the filter history is padded with the first sample there
+        for (std::size_t n = 20; n < samples.size(); ++n)
+        {
+            error = std::max(error, std::abs(samples[n] - std::sin(2 * PI * frequency * n / nominal_rate)));
+        }
+        return error;
+    };
+
+    SampleRecordingHost<double> polyphase_host;
+    PolyphaseResampler polyphase(nominal_rate);
+    feed(polyphase, polyphase_host, real_rate, 10000, 100, signal);
+
+    SampleRecordingHost<double> linear_host;
+    Resampler linear(nominal_rate);
+    feed(linear, linear_host, real_rate, 10000, 100, signal);
+
+    BOOST_REQUIRE_GT(polyphase_host.m_samples[0].size(), 9000);
+    const auto polyphase_error = maxError(polyphase_host.m_samples[0]);
+    const auto linear_error = maxError(linear_host.m_samples[0]);
+    BOOST_TEST_MESSAGE("max error polyphase " << polyphase_error << ", linear " << linear_error);
+    BOOST_CHECK_LT(polyphase_error, 0.01);
+    BOOST_CHECK_LT(polyphase_error * 5, linear_error);
+}
+
+BOOST_AUTO_TEST_CASE(BlockSizeIndependence)
+{
+    auto signal = [](double k) { return std::cos(k * 0.05) + 0.1 * k; };
+
+    SampleRecordingHost<double> small_blocks_host;
+    PolyphaseResampler small_blocks(500);
+    feed(small_blocks, small_blocks_host, 499, 5000, 7, signal);
+
+    SampleRecordingHost<double> large_blocks_host;
+    PolyphaseResampler large_blocks(500);
+    feed(large_blocks, large_blocks_host, 499, 5000, 1000, signal);
+
+    // the filter history is carried across calls
+    const auto count = std::min(small_blocks_host.m_samples[0].size(), large_blocks_host.m_samples[0].size());
+    BOOST_REQUIRE_GT(count, 4900);
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        BOOST_REQUIRE_SMALL(small_blocks_host.m_samples[0][n] - large_blocks_host.m_samples[0][n], 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ThroughputBenchmark)
+{
+    constexpr std::size_t SAMPLE_COUNT = 200000;
+    auto signal = [](double k) { return std::sin(k * 0.01); };
+
+    SampleRecordingHost<double> linear_host;
+    Resampler linear(100000);
+    auto start = std::chrono::steady_clock::now();
+    feed(linear, linear_host, 100010, SAMPLE_COUNT, 1000, signal);
+    const std::chrono::duration<double> linear_time = std::chrono::steady_clock::now() - start;
+
+    SampleRecordingHost<double> polyphase_host;
+    PolyphaseResampler polyphase(100000);
+    start = std::chrono::steady_clock::now();
+    feed(polyphase, polyphase_host, 100010, SAMPLE_COUNT, 1000, signal);
+    const std::chrono::duration<double> polyphase_time = std::chrono::steady_clock::now() - start;
+
+    BOOST_CHECK_GT(polyphase_host.m_samples[0].size(), SAMPLE_COUNT * 99 / 100);
+    BOOST_TEST_MESSAGE(SAMPLE_COUNT << " samples: linear " << SAMPLE_COUNT / linear_time.count() * 1e-6 << " MS/s, polyphase ("
+        << polyphase.getTapCount() << " taps) " << SAMPLE_COUNT / polyphase_time.count() * 1e-6 << " MS/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,8 @@
 #include "odkapi_message_ids.h"
 
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
 #include <numeric>
 
 namespace
@@ -62,6 +64,108 @@ namespace
 
         std::vector<double> received_samples;
     };
+
+    /**
+     * Previous implementation of Resampler::addSamples, keeping the whole previous block and computing every position separately
+     */
+    class ReferenceResampler
+    {
+    public:
+        explicit ReferenceResampler(double nominal_rate)
+            : m_nominal_rate(nominal_rate)
+        {
+        }
+
+        void addSamples(double last_sample_timestamp, const double* data, std::size_t num_samples)
+        {
+            const std::uint64_t last_sample_int = static_cast<std::uint64_t>(std::floor(last_sample_timestamp * m_nominal_rate));
+
+            double first_sample_timestamp = m_last_timestamp;
+            if (!m_input_buffer.empty())
+            {
+                first_sample_timestamp -= m_input_buffer.size() * (last_sample_timestamp - m_last_timestamp) / num_samples;
+            }
+            m_input_buffer.insert(m_input_buffer.end(), data, data + num_samples);
+            const double scale = m_input_buffer.size() / (last_sample_timestamp - first_sample_timestamp);
+
+            for (; m_sample_count < last_sample_int; ++m_sample_count)
+            {
+                const double pos = scale * (m_sample_count / m_nominal_rate - first_sample_timestamp);
+                const int idx = static_cast<int>(std::floor(pos));
+                if (static_cast<std::size_t>(idx) + 1 >= m_input_buffer.size())
+                {
+                    break;
+                }
+                m_output.push_back(m_input_buffer[idx] + (m_input_buffer[idx + 1] - m_input_buffer[idx]) * (pos - idx));
+            }
+
+            m_last_timestamp = last_sample_timestamp;
+            m_input_buffer.assign(data, data + num_samples);
+        }
+
+        std::vector<double> m_output;
+
+    private:
+        double m_nominal_rate;
+        double m_last_timestamp = 0;
+        std::uint64_t m_sample_count = 0;
+        std::vector<double> m_input_buffer;
+    };
+
+    /**
+     * Reproducible timestamp jitter, uniformly distributed in [-amplitude, amplitude)
+     */
+    class Jitter
+    {
+    public:
+        explicit Jitter(double amplitude)
+            : m_amplitude(amplitude)
+        {
+        }
+
+        double operator()()
+        {
+            m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return m_amplitude * (static_cast<double>(m_state >> 11) / 4503599627370496.0 - 1.0);
+        }
+
+    private:
+        double m_amplitude;
+        std::uint64_t m_state = 1;
+    };
+
+    struct TimingError
+    {
+        double m_max_error = 0;         ///< largest deviation from the ideal output in input samples
+        double m_max_step_error = 0;    ///< largest deviation of the difference of consecutive outputs from the ideal ratio
+    };
+
+    /**
+     * Feeds a ramp (input sample k has value k) from a source at real_rate with jittered block timestamps
+     * Linear interpolation of a ramp is exact, so the output only deviates by timing errors. Compares the output samples
+     * after settle_samples with the ideal value n * real_rate / nominal_rate.
+     */
+    TimingError rampTimingError(odk::framework::Resampler& resampler, double real_rate, std::size_t block_size, std::size_t block_count, double jitter_amplitude, std::size_t settle_samples)
+    {
+        TestHost host;
+        Jitter jitter(jitter_amplitude);
+        std::vector<double> block(block_size);
+        for (std::size_t b = 0; b < block_count; ++b)
+        {
+            std::iota(block.begin(), block.end(), static_cast<double>(b * block_size));
+            resampler.addSamples(&host, 0, static_cast<double>((b + 1) * block_size) / real_rate + jitter(), block.data(), block_size);
+        }
+
+        BOOST_REQUIRE_GT(host.received_samples.size(), settle_samples);
+        const double ratio = real_rate / resampler.getNominalSampleRate();
+        TimingError error;
+        for (std::size_t n = settle_samples; n < host.received_samples.size(); ++n)
+        {
+            error.m_max_error = std::max(error.m_max_error, std::abs(host.received_samples[n] - n * ratio));
+            error.m_max_step_error = std::max(error.m_max_step_error, std::abs(host.received_samples[n] - host.received_samples[n - 1] - ratio));
+        }
+        return error;
+    }
 }
 
 BOOST_AUTO_TEST_SUITE(resampler_test_suite)
@@ -191,4 +295,139 @@ BOOST_AUTO_TEST_CASE(ResampleCloseSampleRate)
     }
 }
 
+BOOST_AUTO_TEST_CASE(ResampleThroughput)
+{
+    // a 100kHz source with 0.1% deviation and timestamp jitter, delivered in blocks of 1000 samples
+    constexpr std::size_t BLOCK_COUNT = 200;
+    constexpr std::size_t BLOCK_SIZE = 1000;
+    const double nominal_rate = 100000;
+    const double real_rate = 100100;
+
+    std::vector<double> samples(BLOCK_COUNT * BLOCK_SIZE);
+    std::vector<double> timestamps(BLOCK_COUNT);
+    for (std::size_t n = 0; n < samples.size(); ++n)
+    {
+        samples[n] = std::sin(n * 1e-3);
+    }
+    for (std::size_t block = 0; block < BLOCK_COUNT; ++block)
+    {
+        const double jitter = (block % 3 == 0 ? 1 : -1) * 0.2 / real_rate;
+        timestamps[block] = (block + 1) * BLOCK_SIZE / real_rate + jitter;
+    }
+
+    TestHost host;
+    odk::framework::Resampler resampler(nominal_rate);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t block = 0; block < BLOCK_COUNT; ++block)
+    {
+        resampler.addSamples(&host, 0, timestamps[block], samples.data() + block * BLOCK_SIZE, BLOCK_SIZE);
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+    ReferenceResampler reference(nominal_rate);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t block = 0; block < BLOCK_COUNT; ++block)
+    {
+        reference.addSamples(timestamps[block], samples.data() + block * BLOCK_SIZE, BLOCK_SIZE);
+    }
+    const std::chrono::duration<double> reference_time = std::chrono::steady_clock::now() - start;
+
+    BOOST_TEST_MESSAGE(samples.size() << " samples: " << samples.size() / time.count() * 1e-6 << " MS/s, previous implementation "
+        << samples.size() / reference_time.count() * 1e-6 << " MS/s");
+
+    // the output only differs where jitter moves a position before the last sample of the previous block
+    BOOST_REQUIRE_GT(host.received_samples.size(), samples.size() * 99 / 100);
+    const auto count = std::min(host.received_samples.size(), reference.m_output.size());
+    BOOST_CHECK_LE(std::max(host.received_samples.size(), reference.m_output.size()) - count, 1);
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        BOOST_REQUIRE_SMALL(host.received_samples[n] - reference.m_output[n], 1e-5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TimebaseDriftTracking)
+{
+    // a 1kHz source running 500ppm fast, blocks of 100 samples with up to half a sample of timestamp jitter
+    const double real_rate = 1000.5;
+    const std::size_t block_size = 100;
+
+    odk::framework::ResamplerTimebase block_timebase;
+    odk::framework::ResamplerTimebase tracking_timebase;
+    tracking_timebase.setDriftTracking(0.05);
+    BOOST_CHECK(!block_timebase.isDriftTrackingEnabled());
+    BOOST_CHECK(tracking_timebase.isDriftTrackingEnabled());
+
+    Jitter jitter(0.5e-3);
+    double block_rate_error = 0;
+    double tracking_rate_error = 0;
+    double tracking_position_error = 0;
+    for (std::size_t b = 0; b < 500; ++b)
+    {
+        const double time = static_cast<double>((b + 1) * block_size) / real_rate;
+        const double timestamp = time + jitter();
+        block_timebase.addBlock(timestamp, block_size);
+        tracking_timebase.addBlock(timestamp, block_size);
+        if (b >= 200)
+        {
+            block_rate_error = std::max(block_rate_error, std::abs(block_timebase.getEstimatedSampleRate() - real_rate));
+            tracking_rate_error = std::max(tracking_rate_error, std::abs(tracking_timebase.getEstimatedSampleRate() - real_rate));
+            tracking_position_error = std::max(tracking_position_error, std::abs(tracking_timebase.getPosition(time) - static_cast<double>(tracking_timebase.getSampleCount())));
+            BOOST_CHECK_EQUAL(block_timebase.getTimestampError(), 0);
+            BOOST_CHECK_LT(std::abs(tracking_timebase.getTimestampError()), 1e-3);
+        }
+    }
+
+    BOOST_TEST_MESSAGE("max rate error per block " << block_rate_error << " Hz, tracking " << tracking_rate_error << " Hz");
+    BOOST_CHECK_LT(tracking_rate_error * 10, block_rate_error);
+    BOOST_CHECK_CLOSE(tracking_timebase.getDrift(1000), 5e-4, 20);
+    BOOST_CHECK_LT(tracking_position_error, 0.25);
+
+    // a gap restarts the loop from the measured timestamps
+    const double gap_timestamp = tracking_timebase.getLastTimestamp() + 10.0;
+    tracking_timebase.addBlock(gap_timestamp, block_size);
+    BOOST_CHECK_EQUAL(tracking_timebase.getTimestampError(), 0);
+    BOOST_CHECK_EQUAL(tracking_timebase.getPosition(gap_timestamp), static_cast<double>(tracking_timebase.getSampleCount()));
+
+    tracking_timebase.reset();
+    BOOST_CHECK_EQUAL(tracking_timebase.getSampleCount(), 0);
+    BOOST_CHECK_EQUAL(tracking_timebase.getEstimatedSampleRate(), 0);
+    BOOST_CHECK(tracking_timebase.isDriftTrackingEnabled());
+
+    tracking_timebase.setDriftTracking(0);
+    BOOST_CHECK(!tracking_timebase.isDriftTrackingEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(ResampleWithDriftTracking)
+{
+    const double nominal_rate = 1000;
+    const double real_rate = 1000.5;
+    const double jitter_amplitude = 0.5e-3;
+
+    // without tracking, every block boundary changes the ratio by the jitter of its timestamp
+    odk::framework::Resampler small_blocks(nominal_rate);
+    const auto small_blocks_error = rampTimingError(small_blocks, real_rate, 100, 500, jitter_amplitude, 20000);
+
+    odk::framework::Resampler tracking(nominal_rate);
+    tracking.getTimebase().setDriftTracking(0.05);
+    const auto tracking_error = rampTimingError(tracking, real_rate, 100, 500, jitter_amplitude, 20000);
+
+    // larger blocks see fewer timestamps, a higher gain settles within them
+    odk::framework::Resampler large_blocks(nominal_rate);
+    const auto large_blocks_error = rampTimingError(large_blocks, real_rate, 1000, 60, jitter_amplitude, 20000);
+
+    odk::framework::Resampler large_blocks_tracking(nominal_rate);
+    large_blocks_tracking.getTimebase().setDriftTracking(0.2);
+    const auto large_blocks_tracking_error = rampTimingError(large_blocks_tracking, real_rate, 1000, 60, jitter_amplitude, 20000);
+
+    BOOST_TEST_MESSAGE("timing error in samples (max, max step): blocks of 100 " << small_blocks_error.m_max_error << ", " << small_blocks_error.m_max_step_error
+        << ", tracking " << tracking_error.m_max_error << ", " << tracking_error.m_max_step_error
+        << ", blocks of 1000 " << large_blocks_error.m_max_error << ", " << large_blocks_error.m_max_step_error
+        << ", tracking " << large_blocks_tracking_error.m_max_error << ", " << large_blocks_tracking_error.m_max_step_error);
+    BOOST_CHECK_LT(tracking_error.m_max_error * 3, small_blocks_error.m_max_error);
+    BOOST_CHECK_LT(tracking_error.m_max_step_error * 10, small_blocks_error.m_max_step_error);
+    BOOST_CHECK_LT(large_blocks_tracking_error.m_max_error, large_blocks_error.m_max_error);
+    BOOST_CHECK_LT(large_blocks_tracking_error.m_max_step_error * 5, large_blocks_error.m_max_step_error);
+    BOOST_CHECK_CLOSE(tracking.getTimebase().getDrift(nominal_rate), 5e-4, 20);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_sample_ring_buffer.h"
+#include "test_host.h"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+using odk::framework::SampleRingBuffer;
+using odk::framework::SyncSourceBuffer;
+
+BOOST_AUTO_TEST_SUITE(sample_ring_buffer_test_suite)
+
+BOOST_AUTO_TEST_CASE(wrap_around_test)
+{
+    SampleRingBuffer<int> buffer(6);
+    BOOST_CHECK_EQUAL(buffer.capacity(), 8);
+    BOOST_CHECK(buffer.empty());
+
+    const std::vector<int> samples = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    BOOST_CHECK_EQUAL(buffer.push(samples.data(), 6), 6);
+    BOOST_CHECK_EQUAL(buffer.size(), 6);
+
+    std::vector<int> out(10);
+    BOOST_CHECK_EQUAL(buffer.pop(out.data(), 4), 4);
+    BOOST_CHECK_EQUAL(out[3], 4);
+
+    // full buffer accepts only the free space
+    BOOST_CHECK_EQUAL(buffer.push(samples.data() + 6, 4), 4);
+    BOOST_CHECK_EQUAL(buffer.push(samples.data(), 10), 2);
+    BOOST_CHECK(!buffer.push(0));
+    BOOST_CHECK_EQUAL(buffer.size(), 8);
+
+    std::size_t spans = 0;
+    std::vector<int> consumed;
+    BOOST_CHECK_EQUAL(buffer.consume([&](const int* data, std::size_t count)
+        {
+            ++spans;
+            consumed.insert(consumed.end(), data, data + count);
+        }), 8);
+    BOOST_CHECK_EQUAL(spans, 2);
+    const std::vector<int> expected = { 5, 6, 7, 8, 9, 10, 1, 2 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(consumed.begin(), consumed.end(), expected.begin(), expected.end());
+    BOOST_CHECK(buffer.empty());
+}
+
+BOOST_AUTO_TEST_CASE(producer_consumer_test)
+{
+    constexpr int SAMPLE_COUNT = 200000;
+    SampleRingBuffer<int> buffer(1024);
+
+    std::thread producer([&buffer]
+        {
+            int next = 0;
+            int chunk[37];
+            while (next < SAMPLE_COUNT)
+            {
+                const int count = std::min(37, SAMPLE_COUNT - next);
+                for (int i = 0; i < count; ++i)
+                {
+                    chunk[i] = next + i;
+                }
+                // a full buffer writes only part of the chunk, the rest is sent again
+                const auto written = buffer.push(chunk, count);
+                if (written == 0)
+                {
+                    std::this_thread::yield();
+                }
+                next += static_cast<int>(written);
+            }
+        });
+
+    int expected = 0;
+    bool in_order = true;
+    while (expected < SAMPLE_COUNT)
+    {
+        const auto consumed = buffer.consume([&](const int* data, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    in_order &= data[i] == expected++;
+                }
+            });
+        if (consumed == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    BOOST_CHECK(in_order);
+    BOOST_CHECK_EQUAL(expected, SAMPLE_COUNT);
+    BOOST_CHECK(buffer.empty());
+}
+
+BOOST_AUTO_TEST_CASE(sync_source_buffer_test)
+{
+    SampleRecordingHost<int> host;
+    SyncSourceBuffer<int> source(16);
+    source.reset(1000);
+    BOOST_CHECK_EQUAL(source.getFreeSpace(), 16);
+
+    // nothing ready, nothing sent
+    BOOST_CHECK_EQUAL(source.send(&host, 3), 0);
+    BOOST_CHECK(host.m_blocks.empty());
+
+    const std::vector<int> samples = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    BOOST_CHECK_EQUAL(source.push(samples.data(), 10), 10);
+    BOOST_CHECK_EQUAL(source.send(&host, 3), 10);
+    BOOST_CHECK_EQUAL(source.push(samples.data(), 12), 12);
+    BOOST_CHECK_EQUAL(source.send(&host, 3, 5), 5);
+    BOOST_CHECK_EQUAL(source.send(&host, 3), 7);
+    BOOST_CHECK_EQUAL(source.getNextTick(), 1022);
+
+    const std::vector<std::uint64_t> expected_timestamps = { 1000, 1010, 1015 };
+    std::vector<std::uint64_t> timestamps;
+    for (const auto& block : host.m_blocks)
+    {
+        timestamps.push_back(block.m_timestamp);
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(timestamps.begin(), timestamps.end(), expected_timestamps.begin(), expected_timestamps.end());
+    BOOST_CHECK(host.isContiguous(3));
+    BOOST_REQUIRE_EQUAL(host.m_samples.size(), 1);
+    const auto& sent = host.m_samples[3];
+    BOOST_REQUIRE_EQUAL(sent.size(), 22);
+    BOOST_CHECK_EQUAL(sent[10], 1);
+    BOOST_CHECK_EQUAL(sent[21], 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
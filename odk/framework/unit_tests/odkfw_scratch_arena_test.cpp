@@ -0,0 +1,74 @@
+// Copyright DEWETRON GmbH 2026
+
+#include "odkfw_scratch_arena.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+BOOST_AUTO_TEST_SUITE(scratch_arena_test_suite)
+
+BOOST_AUTO_TEST_CASE(allocate_test)
+{
+    odk::framework::ScratchArena arena;
+    BOOST_CHECK_EQUAL(arena.getCapacity(), 0);
+
+    auto bytes = arena.allocate<std::uint8_t>(3);
+    auto values = arena.allocate<double>(100);
+    BOOST_REQUIRE_EQUAL(bytes.size(), 3);
+    BOOST_REQUIRE_EQUAL(values.size(), 100);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(values.data()) % alignof(double), 0);
+    BOOST_CHECK_GE(static_cast<const void*>(values.data()), static_cast<const void*>(bytes.data() + bytes.size()));
+
+    auto aligned = arena.allocateBytes(16, 64);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0);
+    BOOST_CHECK_GE(arena.getUsedSize(), 3 + 100 * sizeof(double) + 16);
+    BOOST_CHECK_EQUAL(arena.getCapacity(), odk::framework::ScratchArena::MIN_BLOCK_SIZE);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<double>(i);
+    }
+    BOOST_CHECK_EQUAL(values[99], 99.0);
+}
+
+BOOST_AUTO_TEST_CASE(reset_reuses_memory_test)
+{
+    odk::framework::ScratchArena arena;
+    const std::size_t count = odk::framework::ScratchArena::MIN_BLOCK_SIZE / sizeof(double);
+
+    // the demand of the first call does not fit into one block
+    auto first = arena.allocate<double>(count);
+    auto second = arena.allocate<double>(count);
+    BOOST_CHECK_NE(first.data(), second.data());
+    const auto capacity = arena.getCapacity();
+    BOOST_CHECK_GT(capacity, 2 * odk::framework::ScratchArena::MIN_BLOCK_SIZE);
+
+    // after the reset the same demand is served from a single block without growing
+    arena.reset();
+    BOOST_CHECK_EQUAL(arena.getUsedSize(), 0);
+    BOOST_CHECK_EQUAL(arena.getCapacity(), capacity);
+    for (int call = 0; call < 3; ++call)
+    {
+        auto a = arena.allocate<double>(count);
+        auto b = arena.allocate<double>(count);
+        BOOST_CHECK_EQUAL(static_cast<const void*>(b.data()), static_cast<const void*>(a.data() + count));
+        BOOST_CHECK_EQUAL(arena.getCapacity(), capacity);
+        arena.reset();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(allocate_overflow_test)
+{
+    odk::framework::ScratchArena arena;
+    const auto max_count = std::numeric_limits<std::size_t>::max();
+    BOOST_CHECK_THROW(static_cast<void>(arena.allocate<double>(max_count / sizeof(double) + 1)), std::bad_alloc);
+    BOOST_CHECK_THROW(static_cast<void>(arena.allocateBytes(max_count)), std::bad_alloc);
+    BOOST_CHECK_EQUAL(arena.getUsedSize(), 0);
+
+    auto values = arena.allocate<double>(4);
+    BOOST_CHECK_EQUAL(values.size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -124,6 +124,12 @@ namespace
         }
     };
 
+    class ParallelTestInstance : public TestInstance
+    {
+    public:
+        using SoftwareChannelInstance::parallelForChannels;
+    };
+
     class Fixture
     {
     public:
@@ -187,4 +193,36 @@ BOOST_AUTO_TEST_CASE(CreateChannel)
     BOOST_CHECK_EQUAL(csc_response.m_show_channel_details, true);
 }
 
+BOOST_AUTO_TEST_CASE(ParallelForChannels)
+{
+    constexpr std::size_t CHANNEL_COUNT = 16;
+    std::vector<std::vector<double>> data(CHANNEL_COUNT);
+
+    odk::framework::WorkStealingThreadPool pool(4);
+    odk::framework::SoftwareChannelInstance::ProcessingContext context;
+    context.m_thread_pool = &pool;
+    for (std::size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+    {
+        data[channel].assign(1000, static_cast<double>(channel));
+        auto& iterator = context.m_channel_iterators.getIterator(context.m_channel_iterators.addChannel(100 + channel));
+        iterator.addRange(odk::framework::BlockIterator(data[channel].data(), sizeof(double), 0),
+            odk::framework::BlockIterator(data[channel].data() + data[channel].size(), sizeof(double), data[channel].size()));
+    }
+
+    std::vector<double> sums(CHANNEL_COUNT, 0.0);
+    ParallelTestInstance::parallelForChannels(context, [&sums](std::size_t slot, odk::framework::StreamIterator& iterator)
+        {
+            for (; iterator.valid(); ++iterator)
+            {
+                sums[slot] += iterator.value<double>();
+            }
+        });
+
+    for (std::size_t slot = 0; slot < CHANNEL_COUNT; ++slot)
+    {
+        const auto channel = context.m_channel_iterators.getChannelId(slot) - 100;
+        BOOST_CHECK_EQUAL(sums[slot], 1000.0 * static_cast<double>(channel));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 using namespace odk::framework;
 
 BOOST_AUTO_TEST_SUITE(stream_iterator)
@@ -24,6 +28,53 @@ void addAsyncDataRange(StreamIterator& it, const std::vector<ValueType>& data, c
                 BlockIterator(data.data() + data.size(), sizeof(ValueType), timestamp_data.data() + timestamp_data.size(), sizeof(std::uint64_t)));
 }
 
+/**
+ * Builds an iterator from range_count data blocks with a gap after each block,
+ * gaps are appended after all blocks like StreamReader does
+ * @return elapsed seconds for building the iterator, looking up every gap and iterating all blocks
+ */
+double buildAndScanRanges(std::size_t range_count)
+{
+    static const std::vector<double> data(10, 1.0);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    StreamIterator it;
+    it.setTimebase(odk::Timebase(1.0));
+
+    std::vector<StreamIterator::BlockIteratorRange> ranges;
+    ranges.reserve(2 * range_count);
+    for (std::uint64_t i = 0; i < range_count; ++i)
+    {
+        ranges.emplace_back(BlockIterator(data.data(), sizeof(double), i * 20),
+                            BlockIterator(data.data() + data.size(), sizeof(double), i * 20 + 10));
+    }
+    for (std::uint64_t i = 0; i < range_count; ++i)
+    {
+        ranges.emplace_back(BlockIterator(i * 20 + 10), BlockIterator(i * 20 + 20));
+    }
+    it.addRanges(std::move(ranges));
+
+    std::size_t gap_count = 0;
+    for (std::uint64_t i = 0; i < range_count; ++i)
+    {
+        gap_count += it.isInGap(static_cast<double>(i * 20 + 15)) ? 1 : 0;
+        gap_count += it.isInGap(static_cast<double>(i * 20 + 5)) ? 1 : 0;
+    }
+
+    std::size_t sample_count = 0;
+    for (auto chunk = it.nextChunk<double>(); !chunk.empty(); chunk = it.nextChunk<double>())
+    {
+        sample_count += chunk.m_count;
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    BOOST_CHECK_EQUAL(gap_count, range_count);
+    BOOST_CHECK_EQUAL(sample_count, 10 * range_count);
+    return elapsed.count();
+}
+
 template<class ValueType>
 void addAsyncVariableDataRange(StreamIterator& it, const std::vector<ValueType>& data,
                                const std::vector<std::uint64_t>& timestamp_data,
@@ -274,4 +325,259 @@ BOOST_AUTO_TEST_CASE(stream_iterator_async_variable_size_test)
     BOOST_CHECK(!it.valid());
 }
 
+BOOST_AUTO_TEST_CASE(stream_iterator_chunk_test)
+{
+    StreamIterator it;
+    it.setSkipGaps(false);
+
+    std::vector<double> data = { 0, 1, 2, 3, 4 };
+    std::vector<double> data2 = { 5, 6, 7 };
+    addSyncDataRange(it, data, 10);
+    addSyncDataRange(it, data2, 15);
+    it.addRange(BlockIterator(18), BlockIterator(20));
+
+    auto chunk = it.nextChunk<double>();
+    BOOST_CHECK_EQUAL(chunk.m_count, 5);
+    BOOST_CHECK_EQUAL(chunk.m_first_timestamp, 10);
+    BOOST_CHECK(chunk.isContiguous());
+    BOOST_CHECK_EQUAL(chunk.m_data, data.data());
+    BOOST_CHECK_EQUAL(chunk.timestamp(4), 14);
+
+    chunk = it.nextChunk<double>(2);
+    BOOST_CHECK_EQUAL(chunk.m_count, 2);
+    BOOST_CHECK_EQUAL(chunk.value(1), 6);
+    BOOST_CHECK_EQUAL(it.value<double>(), 7);
+    BOOST_CHECK_EQUAL(it.timestamp(), 17);
+
+    chunk = it.nextChunk<double>();
+    BOOST_CHECK_EQUAL(chunk.m_count, 1);
+    BOOST_CHECK_EQUAL(chunk.value(0), 7);
+
+    chunk = it.nextChunk<double>();
+    BOOST_CHECK(chunk.isGap());
+    BOOST_CHECK_EQUAL(chunk.m_count, 2);
+    BOOST_CHECK_EQUAL(chunk.m_first_timestamp, 18);
+    BOOST_CHECK(std::isnan(chunk.value(0)));
+
+    BOOST_CHECK(!it.valid());
+    BOOST_CHECK(it.nextChunk<double>().empty());
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_async_chunk_test)
+{
+    StreamIterator it;
+
+    struct Sample
+    {
+        std::uint64_t m_timestamp;
+        double m_value;
+    };
+    std::vector<Sample> samples = { {3, 1.5}, {7, 2.5}, {9, 3.5} };
+    const auto* ts = &samples.front().m_timestamp;
+    const auto* values = &samples.front().m_value;
+    it.addRange(BlockIterator(values, sizeof(Sample), ts, sizeof(Sample)),
+                BlockIterator(values + 2 * samples.size(), sizeof(Sample), ts + 2 * samples.size(), sizeof(Sample)));
+
+    auto chunk = it.nextChunk<double>();
+    BOOST_CHECK_EQUAL(chunk.m_count, 3);
+    BOOST_CHECK(!chunk.isContiguous());
+    BOOST_CHECK_EQUAL(chunk.m_stride, sizeof(Sample));
+    BOOST_CHECK_EQUAL(chunk.value(2), 3.5);
+    BOOST_CHECK_EQUAL(chunk.timestamp(1), 7);
+    BOOST_CHECK(!it.valid());
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_variable_size_chunk_test)
+{
+    StreamIterator it;
+
+    std::vector<double> data = { 0, 1, 991, 2 };
+    std::vector<std::uint64_t> timestamps = { 0, 10, 991, 20 };
+    std::vector<std::uint32_t> sizes = { 8, 999, 16, 998, 997, 996, 8, 995 };
+    addAsyncVariableDataRange(it, data, timestamps, sizes);
+
+    for (int i = 0; i <= 2; ++i)
+    {
+        auto chunk = it.nextChunk<double>();
+        BOOST_CHECK_EQUAL(chunk.m_count, 1);
+        BOOST_CHECK_EQUAL(chunk.value(0), i);
+        BOOST_CHECK_EQUAL(chunk.m_first_timestamp, i * 10);
+    }
+    BOOST_CHECK(!it.valid());
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_seek_sync_test)
+{
+    StreamIterator it;
+
+    std::vector<double> data = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    addSyncDataRange(it, data, 10);
+    addSyncDataRange(it, data, 30);
+    it.addRange(BlockIterator(20), BlockIterator(30));
+
+    BOOST_CHECK(it.seek(34));
+    BOOST_CHECK_EQUAL(it.timestamp(), 34);
+    BOOST_CHECK_EQUAL(it.value<double>(), 4);
+
+    // gaps are skipped by default
+    BOOST_CHECK(it.seek(25));
+    BOOST_CHECK_EQUAL(it.timestamp(), 30);
+
+    BOOST_CHECK(it.seek(0));
+    BOOST_CHECK_EQUAL(it.timestamp(), 10);
+
+    it += 12;
+    BOOST_CHECK_EQUAL(it.timestamp(), 32);
+    BOOST_CHECK_EQUAL(it.value<double>(), 2);
+
+    BOOST_CHECK(!it.seek(40));
+    BOOST_CHECK(!it.valid());
+
+    it.setSkipGaps(false);
+    BOOST_CHECK(it.seek(25));
+    BOOST_CHECK_EQUAL(it.timestamp(), 25);
+    BOOST_CHECK(it.data() == nullptr);
+
+    it += 7;
+    BOOST_CHECK_EQUAL(it.timestamp(), 32);
+    BOOST_CHECK_EQUAL(it.value<double>(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_seek_async_test)
+{
+    StreamIterator it;
+
+    std::vector<double> data = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::vector<std::uint64_t> timestamps = { 0, 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+    std::vector<std::uint64_t> timestamps2 = { 100, 101, 102, 103, 104, 105, 106, 107, 108, 109 };
+    addAsyncDataRange(it, data, timestamps);
+    addAsyncDataRange(it, data, timestamps2);
+
+    BOOST_CHECK(it.seek(40));
+    BOOST_CHECK_EQUAL(it.value<double>(), 4);
+
+    BOOST_CHECK(it.seek(41));
+    BOOST_CHECK_EQUAL(it.timestamp(), 50);
+
+    BOOST_CHECK(it.seek(95));
+    BOOST_CHECK_EQUAL(it.timestamp(), 100);
+
+    BOOST_CHECK(it.seek(109));
+    BOOST_CHECK_EQUAL(it.value<double>(), 9);
+
+    BOOST_CHECK(!it.seek(110));
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_seek_time_test)
+{
+    StreamIterator it;
+    it.setTimebase(odk::Timebase(10.0));
+
+    std::vector<double> data = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    addSyncDataRange(it, data, 0);
+
+    BOOST_CHECK(it.seekTime(0.5));
+    BOOST_CHECK_EQUAL(it.timestamp(), 5);
+    BOOST_CHECK_CLOSE(it.getTime(), 0.5, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_add_ranges_test)
+{
+    StreamIterator it;
+    it.setTimebase(odk::Timebase(1.0));
+    it.setSkipGaps(false);
+
+    std::vector<double> data = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::vector<StreamIterator::BlockIteratorRange> ranges;
+    ranges.emplace_back(BlockIterator(data.data(), sizeof(double), 30), BlockIterator(data.data() + data.size(), sizeof(double), 40));
+    ranges.emplace_back(BlockIterator(data.data(), sizeof(double), 10), BlockIterator(data.data() + data.size(), sizeof(double), 20));
+    ranges.emplace_back(BlockIterator(20), BlockIterator(30));
+    ranges.emplace_back(BlockIterator(40), BlockIterator(45));
+    it.addRanges(std::move(ranges));
+
+    for (int i = 10; i < 45; ++i)
+    {
+        BOOST_REQUIRE(it.valid());
+        BOOST_CHECK_EQUAL(it.timestamp(), i);
+        ++it;
+    }
+    BOOST_CHECK(!it.valid());
+
+    BOOST_CHECK(!it.isInGap(15));
+    BOOST_CHECK(it.isInGap(20));
+    BOOST_CHECK(it.isInGap(29));
+    BOOST_CHECK(!it.isInGap(30));
+    BOOST_CHECK(it.isInGap(44));
+    BOOST_CHECK(!it.isInGap(45));
+
+    // overlapping gaps are merged
+    it.addRange(BlockIterator(25), BlockIterator(35));
+    BOOST_CHECK(it.isInGap(33));
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_add_ranges_same_start_test)
+{
+    std::vector<double> data = { 0, 1, 2, 3, 4 };
+    std::vector<StreamIterator::BlockIteratorRange> ranges;
+    ranges.emplace_back(BlockIterator(data.data(), sizeof(double), 20), BlockIterator(data.data() + data.size(), sizeof(double), 25));
+    ranges.emplace_back(BlockIterator(data.data(), sizeof(double), 10), BlockIterator(data.data() + data.size(), sizeof(double), 15));
+    ranges.emplace_back(BlockIterator(10), BlockIterator(12));
+    ranges.emplace_back(BlockIterator(20), BlockIterator(21));
+
+    // ranges starting at the same time keep the order of adding them one by one
+    StreamIterator single;
+    single.setSkipGaps(false);
+    for (const auto& range : ranges)
+    {
+        single.addRange(range.first, range.second);
+    }
+
+    StreamIterator batch;
+    batch.setSkipGaps(false);
+    batch.addRange(BlockIterator(data.data(), sizeof(double), 5), BlockIterator(data.data() + data.size(), sizeof(double), 10));
+    single.addRange(BlockIterator(data.data(), sizeof(double), 5), BlockIterator(data.data() + data.size(), sizeof(double), 10));
+    batch.addRanges(std::vector<StreamIterator::BlockIteratorRange>(ranges));
+
+    std::size_t count = 0;
+    while (single.valid())
+    {
+        BOOST_REQUIRE(batch.valid());
+        BOOST_CHECK_EQUAL(batch.timestamp(), single.timestamp());
+        BOOST_CHECK(batch.data() == single.data());
+        if (count == 5)
+        {
+            // the gap starting at 10 was added after the data range starting at 10, so it comes first
+            BOOST_CHECK_EQUAL(batch.timestamp(), 10);
+            BOOST_CHECK(batch.data() == nullptr);
+        }
+        ++single;
+        ++batch;
+        ++count;
+    }
+    BOOST_CHECK(!batch.valid());
+    BOOST_CHECK_EQUAL(count, 18);
+}
+
+BOOST_AUTO_TEST_CASE(stream_iterator_range_scaling_benchmark)
+{
+    // take the best of several runs to reduce timing noise
+    auto best_of = [](std::size_t range_count)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < 3; ++run)
+        {
+            best = std::min(best, buildAndScanRanges(range_count));
+        }
+        return best;
+    };
+
+    const double time_10k = best_of(10000);
+    const double time_100k = best_of(100000);
+
+    BOOST_TEST_MESSAGE("StreamIterator with 10k ranges: " << time_10k * 1e3 << " ms, 100k ranges: " << time_100k * 1e3 << " ms");
+
+    // 10x the ranges has to stay far below the 100x of quadratic behaviour
+    BOOST_CHECK_LT(time_100k, 40.0 * time_10k + 0.01);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -97,4 +97,46 @@ BOOST_AUTO_TEST_CASE(stream_reader_test)
     BOOST_CHECK_EQUAL(iterator1.timestamp(), 102);
 }
 
+BOOST_AUTO_TEST_CASE(stream_reader_block_channels_test)
+{
+    StreamDescriptor sd;
+    sd.m_stream_id = 7;
+    {
+        ChannelDescriptor cd;
+        cd.m_channel_id = 1;
+        cd.m_dimension = 1;
+        cd.m_stride = 64;
+        cd.m_size = 64;
+        cd.m_type = SampleType::DOUBLE;
+        sd.m_channel_descriptors.push_back(cd);
+    }
+
+    BlockChannelDescriptor bcd;
+    bcd.m_channel_id = 1;
+    bcd.m_count = 3;
+    bcd.m_first_sample_index = 10;
+    bcd.m_offset = 0;
+
+    double data1[3] = {1, 2, 3};
+    double data2[3] = {4, 5, 6};
+
+    odk::framework::StreamReader stream_reader(sd);
+    stream_reader.addDataBlock(7, sizeof(data1), &bcd, 1, data1);
+    bcd.m_first_sample_index = 13;
+    stream_reader.addDataBlock(7, sizeof(data2), &bcd, 1, data2);
+
+    auto iterator = stream_reader.createChannelIterator(1);
+    for (int i = 0; i < 6; ++i)
+    {
+        BOOST_REQUIRE(iterator.valid());
+        BOOST_CHECK_EQUAL(iterator.timestamp(), 10 + i);
+        BOOST_CHECK_EQUAL(iterator.value<double>(), i + 1);
+        ++iterator;
+    }
+    BOOST_CHECK(!iterator.valid());
+
+    stream_reader.clearBlocks();
+    BOOST_CHECK(!stream_reader.createChannelIterator(1).valid());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
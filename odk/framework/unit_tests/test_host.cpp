@@ -19,6 +19,8 @@ odk::IfValue* PLUGIN_API TestHost::createValue(odk::IfValue::Type type) const
         return new StringValue({});
     case odk::IfValue::Type::TYPE_XML:
         return new XmlValue({});
+    case odk::IfValue::Type::TYPE_UINT:
+        return new UIntValue(0);
     default:
         BOOST_FAIL("Unsupported type");
         return nullptr;
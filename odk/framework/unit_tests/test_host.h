@@ -1,7 +1,13 @@
 // Copyright DEWETRON GmbH 2021
 #pragma once
 
+#include "odkapi_message_ids.h"
 #include "odkbase_if_host.h"
+#include "odkuni_defines.h"
+
+#include <cstring>
+#include <map>
+#include <vector>
 
 class TestHost : public odk::IfHost
 {
@@ -20,3 +26,69 @@ public:
 
     const odk::IfValue* PLUGIN_API queryXML(const char* context, const char* item, const char* xml, std::uint64_t xml_size) override;
 };
+
+/**
+ * Records the samples sent with odk::host_msg::ADD_CONTIGUOUS_SAMPLES per channel, other data messages fail like in TestHost
+ */
+template <class T>
+class SampleRecordingHost : public TestHost
+{
+public:
+    struct Block
+    {
+        std::uint64_t m_key;
+        std::uint64_t m_timestamp;
+        const void* m_payload;  ///< message data as passed by the plugin, only valid during the call
+        std::size_t m_offset;   ///< index of the first sample in m_samples[m_key]
+        std::size_t m_count;
+    };
+
+    std::uint64_t PLUGIN_API messageSyncData(odk::MessageId msg_id, std::uint64_t key, const void* param, std::uint64_t param_size, const odk::IfValue** ret) override
+    {
+        if (msg_id != odk::host_msg::ADD_CONTIGUOUS_SAMPLES || param_size < sizeof(std::uint64_t))
+        {
+            return TestHost::messageSyncData(msg_id, key, param, param_size, ret);
+        }
+
+        auto& samples = m_samples[key];
+        Block block{key, 0, param, samples.size(), static_cast<std::size_t>((param_size - sizeof(std::uint64_t)) / sizeof(T))};
+        std::memcpy(&block.m_timestamp, param, sizeof(std::uint64_t));
+        samples.resize(block.m_offset + block.m_count);
+        std::memcpy(samples.data() + block.m_offset, static_cast<const std::uint8_t*>(param) + sizeof(std::uint64_t), block.m_count * sizeof(T));
+        m_blocks.push_back(block);
+        return 0;
+    }
+
+    /**
+     * @return the samples sent in block
+     */
+    std::vector<T> getSamples(const Block& block) const
+    {
+        const auto& samples = m_samples.at(block.m_key);
+        return std::vector<T>(samples.begin() + block.m_offset, samples.begin() + block.m_offset + block.m_count);
+    }
+
+    /**
+     * @return true if every block of channel key starts at the timestamp following the previous one
+     */
+    bool isContiguous(std::uint64_t key) const
+    {
+        const Block* previous = nullptr;
+        for (const auto& block : m_blocks)
+        {
+            if (block.m_key != key)
+            {
+                continue;
+            }
+            if (previous && block.m_timestamp != previous->m_timestamp + previous->m_count)
+            {
+                return false;
+            }
+            previous = &block;
+        }
+        return true;
+    }
+
+    std::map<std::uint64_t, std::vector<T>> m_samples;
+    std::vector<Block> m_blocks;
+};
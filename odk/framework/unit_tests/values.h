@@ -2,6 +2,9 @@
 #pragma once
 #include "odkbase_basic_values.h"
 #include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 template<typename I>
 class ValueBase : public I
@@ -61,3 +64,67 @@ public:
 protected:
     std::string m_value;
 };
+
+class UIntValue : public ValueBase<odk::IfUIntValue>
+{
+public:
+    UIntValue(std::uint64_t value) : m_value(value) {}
+    std::uint64_t PLUGIN_API getValue() const final { return m_value; }
+    void PLUGIN_API set(std::uint64_t value) final { m_value = value; }
+protected:
+    std::uint64_t m_value;
+};
+
+class ScalarValue : public ValueBase<odk::IfScalarValue>
+{
+public:
+    ScalarValue(double value, std::string unit = {}) : m_value(value), m_unit(std::move(unit)) {}
+    double PLUGIN_API getValue() const final { return m_value; }
+    const char* PLUGIN_API getUnit() const final { return m_unit.c_str(); }
+    void PLUGIN_API set(double value, const char* unit) final { m_value = value; m_unit = unit; }
+protected:
+    double m_value;
+    std::string m_unit;
+};
+
+class DataBlockValue : public ValueBase<odk::IfDataBlock>
+{
+public:
+    DataBlockValue(std::string description, std::vector<std::uint8_t> data)
+        : m_description(new XmlValue(std::move(description)))
+        , m_data(std::move(data))
+    {}
+    ~DataBlockValue() { m_description->release(); }
+    odk::IfXMLValue* PLUGIN_API getBlockDescription() const final { m_description->addRef(); return m_description; }
+    int PLUGIN_API dataSize() const final { return static_cast<int>(m_data.size()); }
+    const std::uint8_t* PLUGIN_API data() const final { return m_data.data(); }
+    void PLUGIN_API set(odk::IfXMLValue*, const std::uint8_t* data, std::uint32_t length) final { m_data.assign(data, data + length); }
+protected:
+    XmlValue* m_description;
+    std::vector<std::uint8_t> m_data;
+};
+
+class DataBlockListValue : public ValueBase<odk::IfDataBlockList>
+{
+public:
+    DataBlockListValue(std::string description)
+        : m_description(new XmlValue(std::move(description)))
+    {}
+    ~DataBlockListValue()
+    {
+        m_description->release();
+        for (auto block : m_blocks)
+        {
+            block->release();
+        }
+    }
+    odk::IfXMLValue* PLUGIN_API getBlockListDescription() const final { m_description->addRef(); return m_description; }
+    int PLUGIN_API getBlockCount() const final { return static_cast<int>(m_blocks.size()); }
+    odk::IfDataBlock* PLUGIN_API getBlock(int index) const final { m_blocks.at(index)->addRef(); return m_blocks.at(index); }
+    void PLUGIN_API set(odk::IfXMLValue*, odk::IfDataBlock**, std::uint32_t) final {}
+    /// takes ownership of the block
+    void addBlock(DataBlockValue* block) { m_blocks.push_back(block); }
+protected:
+    XmlValue* m_description;
+    std::vector<DataBlockValue*> m_blocks;
+};